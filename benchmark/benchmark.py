@@ -1,196 +1,250 @@
-import openstl
-import torch
-import numpy as np
-import meshio
-import timeit
-from stl import mesh, Mode
-import stl_reader
-import matplotlib.pyplot as plt
-
-#-----------------------------------------------------
-# openstl
-#-----------------------------------------------------
-def create_triangles(num_triangles):
-    triangles = []
-    tri = np.array([[0, 0, 1], [1, 1, 1], [2, 2, 2], [3, 3, 3]])
-    return np.tile(tri[np.newaxis,:,:], (num_triangles,1,1))
-
-def benchmark_write_openstl(num_triangles, filename):
-    triangles = create_triangles(num_triangles)
-    result = timeit.timeit(lambda: openstl.write(filename, triangles, openstl.format.binary), number=5)
-    return result
-
-def benchmark_read_openstl(filename):
-    result = timeit.timeit(lambda: openstl.read(filename), number=5)
-    return result
-
-def benchmark_rotate_openstl(num_triangles):
-    triangles = create_triangles(num_triangles)
-    cos, sin = np.cos(np.pi/3), np.sin(np.pi/3)
-    matrix = np.array([[cos, -sin, 0],[sin, cos, 0], [0,0,1]]) # rotation of pi/3 around z axis
-    result = timeit.timeit(lambda: np.matmul(matrix, triangles.reshape(-1,3).T), number=5)
-    return result
-
-def benchmark_rotate_openstl_torch(num_triangles):
-    triangles = torch.Tensor(create_triangles(num_triangles)).to('cuda')
-    cos, sin = np.cos(np.pi/3), np.sin(np.pi/3)
-    matrix = torch.Tensor([[cos, -sin, 0],[sin, cos, 0], [0,0,1]]).to('cuda') # rotation of pi/3 around z axis
-    result = timeit.timeit(lambda: torch.matmul(matrix, triangles.reshape(-1,3).T), number=5)
-    return result
-
-#-----------------------------------------------------
-# nympy-stl
-#-----------------------------------------------------
-def create_nympystl(num_triangles):
-    triangles = np.zeros(num_triangles, dtype=mesh.Mesh.dtype) 
-    mesh_data = mesh.Mesh(triangles)
-    return mesh_data
+"""Reproducible, CPU-only benchmark of the openstl Python entry points.
+
+Every case runs on generated grid meshes of configurable sizes: untimed warm-up runs, then timed repeats
+summarized by their median and 95th percentile. Memory is measured in a separate untimed run, so that tracing
+does not distort the timings. Results are written as JSON, so that runs of different OpenSTL releases can be
+diffed:
+
+    python benchmark/benchmark.py --sizes 1000 100000 1000000 --repeats 7 --output openstl-4.0.1.json
+"""
+import argparse
+import datetime
+import gc
+import json
+import math
+import os
+import platform
+import shutil
+import statistics
+import sys
+import tempfile
+import time
+import tracemalloc
 
-def benchmark_read_numpy_stl(filename):
-    result = timeit.timeit(lambda: mesh.Mesh.from_file(filename, mode=Mode.BINARY), number=5)
-    return result
+import numpy as np
+import openstl
 
-def benchmark_write_numpy_stl(num_triangles, filename):
-    mesh_data = create_nympystl(num_triangles)
-    result = timeit.timeit(lambda: mesh_data.save(filename, mode=Mode.BINARY), number=5)
-    return result
+try:
+    import resource  # Not available on Windows
+except ImportError:
+    resource = None
 
-def benchmark_rotate_openstl_numpy(num_triangles):
-    mesh_data = create_nympystl(num_triangles)
-    result = timeit.timeit(lambda: mesh_data.rotate([0.0, 0.0, 1.0], np.pi/3), number=5)
-    return result
+GROUPS = ("write", "read", "geometry", "convert", "topology")
+FORMATS = ("binary", "ascii")
 
 #-----------------------------------------------------
-# meshio
+# Meshes
 #-----------------------------------------------------
-def create_meshio_triangles(num_triangles):
-    points = np.array([[1, 1, 1], [2, 2, 2], [3, 3, 3]])
-    cells = [("triangle", np.tile([0,1,2], (num_triangles, 1)))]
-    return meshio.Mesh(points, cells)
-
-def benchmark_write_meshio(num_triangles, filename):
-    mesh = create_meshio_triangles(num_triangles)
-    result = timeit.timeit(lambda: meshio.write(filename, mesh, "stl"), number=5)
-    return result
-
-def benchmark_read_meshio(filename):
-    result = timeit.timeit(lambda: meshio.read(filename), number=5)
-    return result
+def create_grid(num_triangles):
+    """Vertices and faces of a connected planar grid of exactly num_triangles triangles."""
+    side = int(math.ceil(math.sqrt(num_triangles / 2.0))) + 1
+    i, j = np.meshgrid(np.arange(side), np.arange(side), indexing="ij")
+    vertices = np.stack([i.ravel() * 0.5, j.ravel() * 0.5, np.sin(i.ravel() * 0.1) * np.cos(j.ravel() * 0.1)],
+                        axis=1).astype(np.float32)
+    corner = (i[:-1, :-1] * side + j[:-1, :-1]).ravel()
+    lower = np.stack([corner, corner + side, corner + 1], axis=1)
+    upper = np.stack([corner + 1, corner + side, corner + side + 1], axis=1)
+    faces = np.stack([lower, upper], axis=1).reshape(-1, 3)[:num_triangles]
+    return vertices, faces.astype(np.uint32)
+
+
+def create_triangles(vertices, faces):
+    """The (N, 4, 3) float32 array of normals and vertices read and written by openstl."""
+    triangles = np.empty((len(faces), 4, 3), dtype=np.float32)
+    triangles[:, 1:] = vertices[faces]
+    openstl.compute_normals(triangles)  # In place
+    return triangles
+
+
+def rotation(angle=np.pi / 3):
+    cos, sin = np.cos(angle), np.sin(angle)
+    return np.array([[cos, -sin, 0, 0], [sin, cos, 0, 0], [0, 0, 1, 0], [0, 0, 0, 1]])
 
 #-----------------------------------------------------
-# stl-reader
+# Cases
 #-----------------------------------------------------
-def benchmark_read_stl_reader(filename):
-    result = timeit.timeit(lambda: stl_reader.read(filename), number=5)
-    return result
+def create_cases(triangles, vertices, faces, formats, directory, num_threads):
+    """(group, name, format, setup, run) for every case; setup prepares the files a case reads."""
+    cases = []
+    matrix = rotation()
+
+    for fmt in formats:
+        stl_format = getattr(openstl.format, fmt)
+        filename = os.path.join(directory, "benchmark_{}.stl".format(fmt))
+        write = lambda f=filename, s=stl_format: openstl.write(f, triangles, s, num_threads=num_threads)
+        cases += [
+            ("write", "write", fmt, None, write),
+            ("read", "read", fmt, write, lambda f=filename: openstl.read(f)),
+            ("read", "read_batches", fmt, write, lambda f=filename: sum(len(b) for b in openstl.read_batches(f))),
+        ]
+        if fmt == "binary":
+            records = {}
+            def read_records(f=filename):
+                write(f)
+                records["array"] = openstl.read_structured(f)
+            cases += [
+                ("read", "read (mmap)", fmt, write, lambda f=filename: openstl.read(f, mmap=True)),
+                ("read", "read_structured", fmt, write, lambda f=filename: openstl.read_structured(f)),
+                ("write", "write_structured", fmt, read_records,
+                 lambda f=filename: openstl.write_structured(f, records["array"])),
+            ]
+
+    cases += [
+        ("geometry", "compute_normals", None, None, lambda: openstl.compute_normals(triangles)),
+        ("geometry", "find_inconsistent_normals", None, None, lambda: openstl.find_inconsistent_normals(triangles)),
+        ("geometry", "transform", None, None, lambda: openstl.transform(triangles, matrix, num_threads=num_threads)),
+        ("geometry", "transform_vertices", None, None,
+         lambda: openstl.transform_vertices(vertices, matrix, num_threads=num_threads)),
+        ("geometry", "mesh_stats", None, None, lambda: openstl.mesh_stats(triangles, num_threads=num_threads)),
+        ("geometry", "mesh_stats_indexed", None, None,
+         lambda: openstl.mesh_stats_indexed(vertices, faces, num_threads=num_threads)),
+        ("convert", "verticesandfaces", None, None,
+         lambda: openstl.convert.verticesandfaces(triangles, num_threads=num_threads)),
+        ("convert", "verticesandfaces (uint32)", None, None,
+         lambda: openstl.convert.verticesandfaces(triangles, num_threads=num_threads, index_dtype=np.uint32)),
+        ("convert", "triangles", None, None, lambda: openstl.convert.triangles(vertices, faces)),
+        ("topology", "find_connected_components", None, None,
+         lambda: openstl.topology.find_connected_components(vertices, faces, num_threads=num_threads)),
+        ("topology", "find_connected_components (edge)", None, None,
+         lambda: openstl.topology.find_connected_components(vertices, faces, num_threads=num_threads,
+                                                            connectivity="edge")),
+        ("topology", "label_connected_components", None, None,
+         lambda: openstl.topology.label_connected_components(vertices, faces, num_threads=num_threads)),
+        ("topology", "edge_adjacency", None, None,
+         lambda: openstl.topology.edge_adjacency(vertices, faces, num_threads=num_threads)),
+    ]
+    return cases
 
 #-----------------------------------------------------
-# benchmark utils
+# Measurements
 #-----------------------------------------------------
-def benchmark_library(num_triangles_list, write_func, read_func, rotate_func=None, library_name="Library"):
-    write_times = []
-    read_times = []
-    rotate_times = [] if rotate_func else None
-
-    # Warm-up to exclude initialization overhead
-    write_func(1000, "warmup.stl")
-    read_func("warmup.stl")
-
-    for num_triangles in num_triangles_list:
-        write_times.append(write_func(num_triangles, f"benchmark_{num_triangles}.stl"))
-
-    for num_triangles in num_triangles_list:
-        read_times.append(read_func(f"benchmark_{num_triangles}.stl"))
-
-    if rotate_func:
-        for num_triangles in num_triangles_list:
-            rotate_times.append(rotate_func(num_triangles))
-
-    return write_times, read_times, rotate_times
-
-def calculate_speedup(openstl_times, other_times):
-    speedup = np.array(other_times) / np.array(openstl_times)
-    return speedup.round(3)
-
-def display_speedup_results(name, write_speedup, read_speedup, rotate_speedup=None):
-    print(f"Write:\tOpenSTL is {write_speedup.min()} to {write_speedup.max()} X faster than {name}")
-    print(f"Read:\tOpenSTL is {read_speedup.min()} to {read_speedup.max()} X faster than {name}")
-    if rotate_speedup is not None:
-        print(f"Rotate:\tOpenSTL is {rotate_speedup.min()} to {rotate_speedup.max()} X faster than {name}")
-
-def plot_benchmark_results(num_triangles_list, results, labels, filename="benchmark.png"):
-    plt.figure(figsize=(10, 6))
-
-    for result, label, style in results:
-        plt.plot(num_triangles_list, result, label=label, **style)
-
-    plt.xlabel("Number of Triangles", fontsize=12)
-    plt.ylabel("Time (seconds)", fontsize=12)
-    plt.title("Python Benchmark Results", fontsize=14)
-    plt.xscale("log")
-    plt.yscale("log")
-    plt.legend(fontsize=10, handlelength=5, loc='upper left', ncol=3)
-    plt.grid(True, which="both", linestyle="--", linewidth=0.5)
-    plt.tight_layout()
-    plt.xlim(num_triangles_list[0], num_triangles_list[-1] * 1.1)
-    plt.savefig(filename)
-
-if __name__ == "__main__":
-    filename = "benchmark.stl"
-    num_triangles_list = np.logspace(1, 5, 15).round().astype(int)
-
-    # OpenSTL Benchmark
-    openstl_write, openstl_read, openstl_rotate = benchmark_library(num_triangles_list, benchmark_write_openstl, benchmark_read_openstl, benchmark_rotate_openstl, "OpenSTL")
+def percentile(values, fraction):
+    """Nearest-rank percentile, exact for the small sample counts of a benchmark."""
+    ordered = sorted(values)
+    return ordered[max(0, int(math.ceil(fraction * len(ordered))) - 1)]
+
+
+def max_rss_bytes():
+    """Peak resident set size of the process so far, or None where unavailable."""
+    if resource is None:
+        return None
+    peak = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    return peak if sys.platform == "darwin" else peak * 1024
+
+
+def measure(run, warmup, repeats):
+    for _ in range(warmup):
+        run()
+    durations = []
+    gc_enabled = gc.isenabled()
+    gc.disable()
+    try:
+        for _ in range(repeats):
+            start = time.perf_counter()
+            run()
+            durations.append(time.perf_counter() - start)
+    finally:
+        if gc_enabled:
+            gc.enable()
+
+    # Buffers allocated by numpy are traced, including the arrays returned by openstl
+    gc.collect()
+    tracemalloc.start()
+    run()
+    _, traced_peak = tracemalloc.get_traced_memory()
+    tracemalloc.stop()
+    return durations, traced_peak
+
+
+def run_benchmarks(args):
+    results = []
+    directory = tempfile.mkdtemp(prefix="openstl_benchmark_")
+    try:
+        for size in args.sizes:
+            vertices, faces = create_grid(size)
+            triangles = create_triangles(vertices, faces)
+            binary_bytes = 84 + 50 * size
+            for group, name, fmt, setup, run in create_cases(triangles, vertices, faces, args.formats, directory,
+                                                           args.num_threads):
+                if group not in args.groups:
+                    continue
+                if setup is not None:
+                    setup()
+                durations, traced_peak = measure(run, args.warmup, args.repeats)
+                median = statistics.median(durations)
+                file_bytes = None
+                if fmt is not None:
+                    file_bytes = os.path.getsize(os.path.join(directory, "benchmark_{}.stl".format(fmt)))
+                result = {
+                    "name": name,
+                    "group": group,
+                    "format": fmt,
+                    "triangles": size,
+                    "repeats": args.repeats,
+                    "warmup": args.warmup,
+                    "num_threads": args.num_threads,
+                    "median_s": median,
+                    "p95_s": percentile(durations, 0.95),
+                    "min_s": min(durations),
+                    "max_s": max(durations),
+                    "triangles_per_s": size / median if median > 0 else None,
+                    "mb_per_s": (file_bytes or binary_bytes) / median / 1e6 if median > 0 else None,
+                    "peak_traced_bytes": traced_peak,
+                    "max_rss_bytes": max_rss_bytes(),
+                }
+                results.append(result)
+                if not args.quiet:
+                    print("{:<36} {:<7} {:>10} tri {:>10.3f} ms median {:>10.3f} ms p95 {:>10.1f} MB traced".format(
+                        name, fmt or "-", size, median * 1e3, result["p95_s"] * 1e3, traced_peak / 1e6),
+                        file=sys.stderr)
+    finally:
+        shutil.rmtree(directory, ignore_errors=True)
+    return results
+
+
+def metadata(args):
+    return {
+        "openstl_version": getattr(openstl, "__version__", None),
+        "numpy_version": np.__version__,
+        "python_version": platform.python_version(),
+        "platform": platform.platform(),
+        "processor": platform.processor() or platform.machine(),
+        "cpu_count": os.cpu_count(),
+        "timestamp": datetime.datetime.now(datetime.timezone.utc).isoformat(),
+        "arguments": vars(args),
+    }
+
+
+def parse_arguments(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--sizes", type=int, nargs="+", default=[1000, 10000, 100000, 1000000],
+                        help="mesh sizes in triangles (default: %(default)s)")
+    parser.add_argument("--formats", nargs="+", choices=FORMATS, default=list(FORMATS),
+                        help="file formats of the read and write cases (default: %(default)s)")
+    parser.add_argument("--groups", nargs="+", choices=GROUPS, default=list(GROUPS),
+                        help="groups of entry points to run (default: all)")
+    parser.add_argument("--repeats", type=int, default=5, help="timed runs per case (default: %(default)s)")
+    parser.add_argument("--warmup", type=int, default=1, help="untimed runs per case (default: %(default)s)")
+    parser.add_argument("--num-threads", type=int, default=1,
+                        help="num_threads of the entry points that accept it, 0 for all cores (default: %(default)s)")
+    parser.add_argument("--output", help="JSON file of the results (default: standard output)")
+    parser.add_argument("--quiet", action="store_true", help="do not print progress to standard error")
+    args = parser.parse_args(argv)
+    if args.repeats < 1 or args.warmup < 0 or min(args.sizes) < 1:
+        parser.error("--repeats and --sizes must be positive and --warmup non-negative")
+    return args
+
+
+def main(argv=None):
+    args = parse_arguments(argv)
+    report = {"metadata": metadata(args), "results": run_benchmarks(args)}
+    if args.output:
+        with open(args.output, "w") as file:
+            json.dump(report, file, indent=2)
+    else:
+        json.dump(report, sys.stdout, indent=2)
+        print()
 
-    # OpenSTL + PyTorch Benchmark (if available)
-    if torch.cuda.is_available():
-        _, _, openstl_rotate_torch = benchmark_library(num_triangles_list, lambda *args: None, lambda *args: None, benchmark_rotate_openstl_torch, "OpenSTL + PyTorch")
 
-    # Numpy STL Benchmark
-    numpy_write, numpy_read, numpy_rotate = benchmark_library(num_triangles_list, benchmark_write_numpy_stl, benchmark_read_numpy_stl, benchmark_rotate_openstl_numpy, "Numpy STL")
-
-    # Meshio Benchmark
-    meshio_write, meshio_read, _ = benchmark_library(num_triangles_list, benchmark_write_meshio, benchmark_read_meshio, library_name="Meshio")
-
-    # STL Reader Benchmark (Read-only)
-    _, stl_reader_read, _ = benchmark_library(num_triangles_list, benchmark_write_openstl, benchmark_read_stl_reader, library_name="STL Reader")
-
-    # Calculate and display speedup
-    write_speedup_np = calculate_speedup(openstl_write, numpy_write)
-    read_speedup_np = calculate_speedup(openstl_read, numpy_read)
-    rotate_speedup_np = calculate_speedup(openstl_rotate, numpy_rotate)
-
-    display_speedup_results("numpy-stl", write_speedup_np, read_speedup_np, rotate_speedup_np)
-
-    if torch.cuda.is_available():
-        rotate_speedup_torch = calculate_speedup(openstl_rotate_torch, numpy_rotate)
-        print(f"Rotate:\tOpenSTL + PyTorch is {rotate_speedup_torch.min()} to {rotate_speedup_torch.max()} X faster than numpy-stl")
-
-    write_speedup_meshio = calculate_speedup(openstl_write, meshio_write)
-    read_speedup_meshio = calculate_speedup(openstl_read, meshio_read)
-
-    display_speedup_results("meshio", write_speedup_meshio, read_speedup_meshio)
-
-    read_speedup_stl_reader = calculate_speedup(openstl_read, stl_reader_read)
-    print(f"Read:\tOpenSTL is {read_speedup_stl_reader.min()} to {read_speedup_stl_reader.max()} X faster than stl_reader")
-
-    # Plot results
-    styles = [
-        (openstl_write, "Write (OpenSTL)", {"color": "green", "linestyle": "-", "marker": "s", "markersize": 7, "linewidth": 3}),
-        (openstl_read, "Read (OpenSTL)", {"color": "blue", "linestyle": "-", "marker": "s", "markersize": 7, "linewidth": 3}),
-        (openstl_rotate, "Rotate (OpenSTL)", {"color": "red", "linestyle": "-", "marker": "s", "markersize": 7, "linewidth": 3})
-    ]
-
-    if torch.cuda.is_available():
-        styles.append((openstl_rotate_torch, "Rotate (OpenSTL + PyTorch)", {"color": "purple", "linestyle": "-", "marker": "s", "markersize": 7, "linewidth": 3}))
-
-    styles += [
-        (numpy_write, "Write (numpy-stl)", {"color": "green", "linestyle": "--", "marker": "o", "markersize": 5, "alpha": 0.5}),
-        (numpy_read, "Read (numpy-stl)", {"color": "blue", "linestyle": "--", "marker": "o", "markersize": 5, "alpha": 0.5}),
-        (numpy_rotate, "Rotate (numpy-stl)", {"color": "red", "linestyle": "--", "marker": "o", "markersize": 5, "alpha": 0.5}),
-        (meshio_write, "Write (meshio)", {"color": "green", "linestyle": ":", "marker": "^", "markersize": 5, "alpha": 0.5}),
-        (meshio_read, "Read (meshio)", {"color": "blue", "linestyle": ":", "marker": "^", "markersize": 5, "alpha": 0.5}),
-        (stl_reader_read, "Read (stl_reader)", {"color": "blue", "linestyle": "-.", "marker": "x", "markersize": 5, "alpha": 0.5}),
-    ]
-
-    plot_benchmark_results(num_triangles_list, styles, "benchmark.png")
\ No newline at end of file
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,124 @@
+#include <catch2/catch_test_macros.hpp>
+#include "openstl/benchmark/benchutils.h"
+#include "openstl/core/stl.h"
+
+using namespace openstl;
+
+namespace {
+    // Reference implementation of the former unordered_map-based conversion, kept as a baseline
+    struct LegacyVec3Hash {
+        std::size_t operator()(const Vec3& vertex) const {
+            return std::hash<float>{}(vertex.x) ^ std::hash<float>{}(vertex.y) ^ std::hash<float>{}(vertex.z);
+        }
+    };
+
+    std::tuple<std::vector<Vec3>, std::vector<Face>> legacyConvertToVerticesAndFaces(const std::vector<Triangle>& triangles)
+    {
+        std::unordered_map<Vec3, std::vector<size_t>, LegacyVec3Hash> inverseMap{};
+        size_t triangleIdx{0};
+        for (const auto& tri : triangles) {
+            for (const auto vertex : {&tri.v0, &tri.v1, &tri.v2}) {
+                auto it = inverseMap.find(*vertex);
+                if (it != std::end(inverseMap)) {
+                    it->second.emplace_back(triangleIdx);
+                    continue;
+                }
+                inverseMap[*vertex] = {triangleIdx};
+            }
+            ++triangleIdx;
+        }
+        std::vector<Vec3> vertices{}; vertices.reserve(inverseMap.size());
+        std::vector<Face> faces(triangles.size());
+        std::vector<uint8_t> vertexPositionInFace(triangles.size(), 0u);
+        size_t vertexIdx{0};
+        for (const auto& item : inverseMap) {
+            vertices.emplace_back(item.first);
+            for (const auto faceIdx : item.second)
+                faces[faceIdx][vertexPositionInFace[faceIdx]++] = vertexIdx;
+            ++vertexIdx;
+        }
+        return std::make_tuple(std::move(vertices), std::move(faces));
+    }
+}
+
+TEST_CASE("convertToVerticesAndFaces throughput", "[benchmark][convert]") {
+    const size_t count = 1000000;
+    const auto triangles = benchutils::createGridTriangles(count);
+    const size_t bytes = triangles.size() * sizeof(Triangle);
+    std::printf("\nconvertToVerticesAndFaces, %zu triangles\n", count);
+
+    const double legacy = benchutils::measureMedian([&] {
+        REQUIRE(std::get<1>(legacyConvertToVerticesAndFaces(triangles)).size() == count);
+    }, 3);
+    benchutils::report("legacy unordered_map welding", legacy, bytes, count);
+
+    const double welded = benchutils::measureMedian([&] {
+        REQUIRE(std::get<1>(convertToVerticesAndFaces(triangles)).size() == count);
+    }, 3);
+    benchutils::report("convertToVerticesAndFaces", welded, bytes, count);
+
+    const double compact = benchutils::measureMedian([&] {
+        REQUIRE(std::get<1>(convertToVerticesAndFaces<uint32_t>(triangles)).size() == count);
+    }, 3);
+    benchutils::report("convertToVerticesAndFaces, 32-bit faces", compact, bytes, count);
+
+    for (const size_t numThreads : {2u, 4u, 0u}) {
+        WeldOptions options{};
+        options.num_threads = numThreads;
+        const double parallel = benchutils::measureMedian([&] {
+            REQUIRE(std::get<1>(convertToVerticesAndFaces(triangles, options)).size() == count);
+        }, 3);
+        const std::string name = "convertToVerticesAndFaces, " + std::to_string(resolveThreadCount(numThreads)) + " threads";
+        benchutils::report(name, parallel, bytes, count);
+    }
+
+    WeldOptions tolerant{};
+    tolerant.tolerance = 1e-3f;
+    const double grid = benchutils::measureMedian([&] {
+        REQUIRE(std::get<1>(convertToVerticesAndFaces(triangles, tolerant)).size() == count);
+    }, 3);
+    benchutils::report("convertToVerticesAndFaces, tolerance 1e-3", grid, bytes, count);
+}
+
+TEST_CASE("Face traversal locality by vertex order", "[benchmark][convert]") {
+    const size_t count = 4000000;
+    const auto triangles = benchutils::createGridTriangles(count);
+    const size_t bytes = triangles.size() * sizeof(Triangle);
+    std::printf("\nface traversal (total area), %zu triangles\n", count);
+
+    auto traverse = [](const std::vector<Vec3>& vertices, const auto& faces) {
+        double area{0.0};
+        for (const auto& face : faces) {
+            const auto n = crossProduct(vertices[face[1]] - vertices[face[0]], vertices[face[2]] - vertices[face[0]]);
+            area += 0.5 * std::sqrt(static_cast<double>(n.x * n.x + n.y * n.y + n.z * n.z));
+        }
+        return area;
+    };
+
+    auto measure = [&](const std::string& name, const std::vector<Vec3>& vertices, const auto& faces) {
+        double area{0.0};
+        const double seconds = benchutils::measureMedian([&] { area = traverse(vertices, faces); });
+        benchutils::report(name, seconds, bytes, count);
+        return area;
+    };
+
+    const auto legacy = legacyConvertToVerticesAndFaces(triangles);
+    // The legacy conversion does not preserve the vertex order within faces, so areas only match approximately
+    const double reference = measure("unordered_map order (legacy)", std::get<0>(legacy), std::get<1>(legacy));
+
+    WeldOptions options{};
+    const auto firstAppearance = convertToVerticesAndFaces(triangles, options);
+    const double area = measure("first-appearance order", std::get<0>(firstAppearance), std::get<1>(firstAppearance));
+    REQUIRE(std::abs(area - reference) <= 1e-9 * reference);
+
+    options.vertex_order = VertexOrder::Morton;
+    const auto morton = convertToVerticesAndFaces(triangles, options);
+    REQUIRE(measure("Morton order", std::get<0>(morton), std::get<1>(morton)) == area);
+    const auto compact = convertToVerticesAndFaces<uint32_t>(triangles, options);
+    REQUIRE(measure("Morton order, 32-bit faces", std::get<0>(compact), std::get<1>(compact)) == area);
+
+    const double sorting = benchutils::measureMedian([&] {
+        REQUIRE(std::get<1>(convertToVerticesAndFaces(triangles, options)).size() == count);
+    }, 3);
+    benchutils::report("convertToVerticesAndFaces, Morton order", sorting, bytes, count);
+}
@@ -0,0 +1,72 @@
+#include <catch2/catch_test_macros.hpp>
+#include "openstl/benchmark/benchutils.h"
+#include "openstl/core/stl.h"
+#include <sstream>
+
+using namespace openstl;
+
+namespace {
+    // Reference implementation of the former istringstream/getline ASCII reader, kept as a baseline
+    void legacyParseThreeFloatsAfter(std::string_view line, std::string_view keyword, float& a, float& b, float& c)
+    {
+        line = ltrim(line);
+        if (!istarts_with(line, keyword)) {
+            throw std::runtime_error("Expected keyword '" + std::string(keyword) + "' not found.");
+        }
+        std::istringstream iss{std::string(ltrim(line.substr(keyword.size())))};
+        iss.imbue(std::locale::classic());
+        if (!(iss >> a >> b >> c)) {
+            throw std::runtime_error("Failed to parse three floats after '" + std::string(keyword) + "'.");
+        }
+    }
+
+    std::vector<Triangle> legacyDeserializeAsciiStl(std::istream& stream)
+    {
+        std::vector<Triangle> tris;
+        std::string raw;
+        while (std::getline(stream, raw)) {
+            std::string_view line = ltrim(std::string_view(raw));
+            if (!istarts_with(line, "facet normal")) continue;
+            Triangle t{};
+            legacyParseThreeFloatsAfter(line, "facet normal", t.normal.x, t.normal.y, t.normal.z);
+            getline_or_throw(stream, "'outer loop'");
+            for (auto* v : {&t.v0, &t.v1, &t.v2}) {
+                const std::string vertexLine = getline_or_throw(stream, "vertex line");
+                legacyParseThreeFloatsAfter(vertexLine, "vertex", v->x, v->y, v->z);
+            }
+            tris.push_back(t);
+        }
+        return tris;
+    }
+}
+
+TEST_CASE("ASCII STL read throughput", "[benchmark][ascii][read]") {
+    const size_t count = 200000;
+    std::stringstream out;
+    serializeAsciiStl(benchutils::createRandomTriangles(count), out);
+    const std::string text = out.str();
+
+    std::printf("\nASCII STL read, %zu triangles, %.1f MB\n", count, static_cast<double>(text.size()) / 1e6);
+
+    const double legacy = benchutils::measureMedian([&] {
+        std::stringstream ss(text);
+        REQUIRE(legacyDeserializeAsciiStl(ss).size() == count);
+    });
+    benchutils::report("legacy istringstream reader", legacy, text.size(), count);
+
+    const double stream = benchutils::measureMedian([&] {
+        std::stringstream ss(text);
+        REQUIRE(deserializeAsciiStl(ss).size() == count);
+    });
+    benchutils::report("deserializeAsciiStl (stream)", stream, text.size(), count);
+
+    const double buffer = benchutils::measureMedian([&] {
+        REQUIRE(deserializeAsciiStlBuffer(text.data(), text.size()).size() == count);
+    });
+    benchutils::report("deserializeAsciiStlBuffer", buffer, text.size(), count);
+
+    const double parallel = benchutils::measureMedian([&] {
+        REQUIRE(deserializeAsciiStlBufferParallel(text.data(), text.size()).size() == count);
+    });
+    benchutils::report("deserializeAsciiStlBufferParallel", parallel, text.size(), count);
+}
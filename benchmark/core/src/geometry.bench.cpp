@@ -0,0 +1,131 @@
+#include <catch2/catch_test_macros.hpp>
+#include "openstl/benchmark/benchutils.h"
+#include "openstl/core/stl.h"
+
+using namespace openstl;
+
+TEST_CASE("Normal computation throughput", "[benchmark][normals]") {
+    const size_t count = 2000000;
+    auto triangles = benchutils::createRandomTriangles(count);
+    const size_t bytes = count * sizeof(Triangle);
+    std::printf("\nnormal computation, %zu triangles\n", count);
+
+    const double scalar = benchutils::measureMedian([&] {
+        for (auto& tri : triangles) {
+            const auto n = crossProduct(tri.v1 - tri.v0, tri.v2 - tri.v0);
+            const float length = std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z);
+            tri.normal = length > 0.f ? Vec3{n.x / length, n.y / length, n.z / length} : Vec3{0.f, 0.f, 0.f};
+        }
+    });
+    benchutils::report("per-triangle crossProduct", scalar, bytes, count);
+
+    const double kernel = benchutils::measureMedian([&] { computeNormals(triangles); });
+    benchutils::report("computeNormals", kernel, bytes, count);
+
+    const double check = benchutils::measureMedian([&] { REQUIRE(findInconsistentNormals(triangles).empty()); });
+    benchutils::report("findInconsistentNormals", check, bytes, count);
+}
+
+TEST_CASE("Structure-of-arrays kernels", "[benchmark][soa]") {
+    const size_t count = 2000000;
+    auto triangles = benchutils::createRandomTriangles(count);
+    const size_t bytes = count * sizeof(Triangle);
+    std::printf("\nstructure-of-arrays kernels, %zu triangles\n", count);
+
+    TriangleArrays arrays;
+    const double transpose = benchutils::measureMedian([&] { arrays = toTriangleArrays(triangles); });
+    benchutils::report("toTriangleArrays", transpose, bytes, count);
+    const double reuse = benchutils::measureMedian([&] { arrays.assignRecords(triangles.data(), count, sizeof(Triangle)); });
+    benchutils::report("TriangleArrays::assignRecords, reused", reuse, bytes, count);
+    const double back = benchutils::measureMedian([&] { arrays.toRecords(triangles.data(), sizeof(Triangle)); });
+    benchutils::report("TriangleArrays::toRecords", back, bytes, count);
+
+    const double packedNormals = benchutils::measureMedian([&] { computeNormals(triangles); });
+    benchutils::report("computeNormals, packed triangles", packedNormals, bytes, count);
+    const double soaNormals = benchutils::measureMedian([&] { computeNormals(arrays); });
+    benchutils::report("computeNormals, TriangleArrays", soaNormals, bytes, count);
+
+    BoundingBox box{}, soaBox{};
+    const double packedBox = benchutils::measureMedian([&] { box = computeBoundingBox(triangles); });
+    benchutils::report("computeBoundingBox, packed triangles", packedBox, bytes, count);
+    const double soaBoxTime = benchutils::measureMedian([&] { soaBox = computeBoundingBox(arrays); });
+    benchutils::report("computeBoundingBox, TriangleArrays", soaBoxTime, bytes, count);
+    REQUIRE(box.lower == soaBox.lower);
+    REQUIRE(box.upper == soaBox.upper);
+}
+
+TEST_CASE("Affine transform throughput", "[benchmark][transform]") {
+    const size_t count = 2000000;
+    auto triangles = benchutils::createRandomTriangles(count);
+    const size_t bytes = count * sizeof(Triangle);
+    std::printf("\naffine transform, %zu triangles\n", count);
+    const float c = std::cos(1.0471976f), s = std::sin(1.0471976f);
+    const AffineMatrix matrix{c, -s, 0.f, 1.f, s, c, 0.f, 2.f, 0.f, 0.f, 1.f, 3.f};
+
+    const double scalar = benchutils::measureMedian([&] {
+        auto apply = [&matrix](const Vec3& v) {
+            return Vec3{matrix[0] * v.x + matrix[1] * v.y + matrix[2] * v.z + matrix[3],
+                        matrix[4] * v.x + matrix[5] * v.y + matrix[6] * v.z + matrix[7],
+                        matrix[8] * v.x + matrix[9] * v.y + matrix[10] * v.z + matrix[11]};
+        };
+        for (auto& tri : triangles) {
+            tri.v0 = apply(tri.v0); tri.v1 = apply(tri.v1); tri.v2 = apply(tri.v2);
+            const Vec3 n = apply(tri.normal);
+            tri.normal = {n.x - matrix[3], n.y - matrix[7], n.z - matrix[11]}; // Rotation only
+        }
+    });
+    benchutils::report("per-triangle loop (rotation normals)", scalar, bytes, count);
+
+    for (size_t numThreads : {size_t{1}, size_t{4}, size_t{0}}) {
+        const double time = benchutils::measureMedian([&] { transformTriangles(triangles, matrix, numThreads); });
+        benchutils::report("transformTriangles, " + std::to_string(numThreads) + " threads", time, bytes, count);
+    }
+
+    auto arrays = toTriangleArrays(triangles);
+    const double soa = benchutils::measureMedian([&] { transformTriangles(arrays, matrix); });
+    benchutils::report("transformTriangles, TriangleArrays", soa, bytes, count);
+
+    std::vector<Vec3> vertices(count * 3u);
+    for (size_t i = 0; i < count; ++i) {
+        vertices[3 * i] = triangles[i].v0; vertices[3 * i + 1] = triangles[i].v1; vertices[3 * i + 2] = triangles[i].v2;
+    }
+    const double vertexTime = benchutils::measureMedian([&] { transformVertices(vertices, matrix); });
+    benchutils::report("transformVertices, 6M vertices", vertexTime, vertices.size() * sizeof(Vec3), count);
+}
+
+TEST_CASE("Mesh statistics throughput", "[benchmark][stats]") {
+    const size_t count = 2000000;
+    const auto triangles = benchutils::createRandomTriangles(count);
+    const size_t bytes = count * sizeof(Triangle);
+    std::printf("\nmesh statistics, %zu triangles\n", count);
+
+    double area{0.0};
+    const double scalar = benchutils::measureMedian([&] {
+        Vec3 lower = triangles[0].v0, upper = lower;
+        double sum{0.0}, volume{0.0};
+        for (const auto& tri : triangles) {
+            for (const auto& v : {tri.v0, tri.v1, tri.v2}) {
+                lower = {std::min(lower.x, v.x), std::min(lower.y, v.y), std::min(lower.z, v.z)};
+                upper = {std::max(upper.x, v.x), std::max(upper.y, v.y), std::max(upper.z, v.z)};
+            }
+            const auto n = crossProduct(tri.v1 - tri.v0, tri.v2 - tri.v0);
+            sum += std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z) / 2.0;
+            volume += (tri.v0.x * n.x + tri.v0.y * n.y + tri.v0.z * n.z) / 6.0;
+        }
+        area = sum + 0.0 * volume + 0.0 * (upper.x - lower.x);
+    });
+    benchutils::report("per-triangle loop", scalar, bytes, count);
+
+    for (size_t numThreads : {size_t{1}, size_t{0}}) {
+        MeshStats stats{};
+        const double time = benchutils::measureMedian([&] { stats = computeMeshStats(triangles, numThreads); });
+        benchutils::report("computeMeshStats, " + std::to_string(numThreads) + " threads", time, bytes, count);
+        REQUIRE(std::abs(stats.area - area) < 1e-4 * area);
+    }
+
+    std::vector<Vec3> vertices;
+    std::vector<Face> faces;
+    std::tie(vertices, faces) = convertToVerticesAndFaces(triangles);
+    const double indexed = benchutils::measureMedian([&] { computeIndexedMeshStats(vertices, faces); });
+    benchutils::report("computeIndexedMeshStats", indexed, bytes, count);
+}
@@ -0,0 +1,120 @@
+#include <catch2/catch_test_macros.hpp>
+#include "openstl/benchmark/benchutils.h"
+#include "openstl/core/stl.h"
+#include <cstdio>
+#include <filesystem>
+
+using namespace openstl;
+
+namespace {
+    // Reference implementation of the former operator<< / std::endl ASCII writer, kept as a baseline
+    template<typename Stream, typename Container>
+    void legacySerializeAsciiStl(const Container& triangles, Stream& stream) {
+        stream << "solid\n";
+        for (const auto& tri : triangles) {
+            stream << "facet normal " << tri.normal.x << " " << tri.normal.y << " " << tri.normal.z << std::endl;
+            stream << "outer loop" << std::endl;
+            stream << "vertex " << tri.v0.x << " " << tri.v0.y << " " << tri.v0.z << std::endl;
+            stream << "vertex " << tri.v1.x << " " << tri.v1.y << " " << tri.v1.z << std::endl;
+            stream << "vertex " << tri.v2.x << " " << tri.v2.y << " " << tri.v2.z << std::endl;
+            stream << "endloop" << std::endl;
+            stream << "endfacet" << std::endl;
+        }
+        stream << "endsolid\n";
+    }
+
+    // Reference implementation of the former per-triangle binary writer, kept as a baseline
+    template<typename Stream, typename Container>
+    void legacySerializeBinaryStl(const Container& triangles, Stream& stream) {
+        char header[80] = "STL Exported by OpenSTL [https://github.com/Innoptech/OpenSTL]";
+        stream.write(header, sizeof(header));
+        auto triangleCount = static_cast<uint32_t>(triangles.size());
+        stream.write(reinterpret_cast<const char*>(&triangleCount), sizeof(triangleCount));
+        for (const auto& tri : triangles) {
+            stream.write(reinterpret_cast<const char*>(&tri), sizeof(Triangle));
+        }
+    }
+
+    // A forward-only view without data(), as the bindings' StridedSpan over (N,4,3) arrays
+    struct ForwardView {
+        const std::vector<Triangle>& triangles;
+        std::vector<Triangle>::const_iterator begin() const { return triangles.begin(); }
+        std::vector<Triangle>::const_iterator end() const { return triangles.end(); }
+        size_t size() const { return triangles.size(); }
+    };
+
+    size_t fileSize(const std::string& filename) {
+        return static_cast<size_t>(std::filesystem::file_size(filename));
+    }
+}
+
+TEST_CASE("ASCII STL write throughput", "[benchmark][ascii][write]") {
+    const size_t count = 200000;
+    const auto triangles = benchutils::createRandomTriangles(count);
+    const std::string filename = (std::filesystem::temp_directory_path() / "openstl_write.bench.stl").string();
+    std::printf("\nASCII STL write, %zu triangles\n", count);
+
+    const double legacy = benchutils::measureMedian([&] {
+        std::ofstream file(filename, std::ios::binary);
+        legacySerializeAsciiStl(triangles, file);
+    });
+    benchutils::report("legacy operator<< writer", legacy, fileSize(filename), count);
+
+    const double buffered = benchutils::measureMedian([&] {
+        std::ofstream file(filename, std::ios::binary);
+        serializeAsciiStl(triangles, file);
+    });
+    benchutils::report("serializeAsciiStl, shortest", buffered, fileSize(filename), count);
+
+    const double rounded = benchutils::measureMedian([&] {
+        std::ofstream file(filename, std::ios::binary);
+        serializeAsciiStl(triangles, file, 6);
+    });
+    benchutils::report("serializeAsciiStl, 6 digits", rounded, fileSize(filename), count);
+
+    for (const size_t numThreads : {2u, 0u}) {
+        const double parallel = benchutils::measureMedian([&] {
+            std::ofstream file(filename, std::ios::binary);
+            serializeAsciiStlParallel(triangles, file, numThreads);
+        });
+        const std::string name = "serializeAsciiStlParallel, " + std::to_string(resolveThreadCount(numThreads)) + " threads";
+        benchutils::report(name, parallel, fileSize(filename), count);
+    }
+
+    std::ifstream file(filename, std::ios::binary);
+    REQUIRE(deserializeAsciiStl(file).size() == count);
+    file.close();
+    std::remove(filename.c_str());
+}
+
+TEST_CASE("Binary STL write throughput", "[benchmark][binary][write]") {
+    const size_t count = 2000000;
+    const auto triangles = benchutils::createRandomTriangles(count);
+    const size_t bytes = BINARY_STL_HEADER_SIZE + count * sizeof(Triangle);
+    const std::string filename = (std::filesystem::temp_directory_path() / "openstl_write.bench.stl").string();
+    std::printf("\nBinary STL write, %zu triangles\n", count);
+
+    const double legacy = benchutils::measureMedian([&] {
+        std::ofstream file(filename, std::ios::binary);
+        legacySerializeBinaryStl(ForwardView{triangles}, file);
+    });
+    benchutils::report("legacy per-triangle writer", legacy, bytes, count);
+
+    const double staged = benchutils::measureMedian([&] {
+        std::ofstream file(filename, std::ios::binary);
+        serializeBinaryStl(ForwardView{triangles}, file);
+    });
+    benchutils::report("serializeBinaryStl, staged", staged, bytes, count);
+
+    const double contiguous = benchutils::measureMedian([&] {
+        std::ofstream file(filename, std::ios::binary);
+        serializeBinaryStl(triangles, file);
+    });
+    benchutils::report("serializeBinaryStl, contiguous", contiguous, bytes, count);
+
+    const double raw = benchutils::measureMedian([&] { writeBinaryStlFile(filename, triangles); });
+    benchutils::report("writeBinaryStlFile", raw, bytes, count);
+
+    REQUIRE(fileSize(filename) == bytes);
+    std::remove(filename.c_str());
+}
@@ -0,0 +1,65 @@
+#include <catch2/catch_test_macros.hpp>
+#include "openstl/benchmark/benchutils.h"
+#include "openstl/core/stl.h"
+#include <cstdio>
+#include <filesystem>
+
+using namespace openstl;
+
+namespace {
+    /**
+     * @brief Time a case and report it with the peak resident memory of its runs.
+     */
+    template<typename Function>
+    void measureCase(const std::string& name, size_t bytes, size_t triangles, Function&& fn) {
+        benchutils::resetPeakMemory();
+        const double seconds = benchutils::measureMedian(fn, benchutils::sweepRepeats(triangles));
+        benchutils::report(name, seconds, bytes, triangles, benchutils::peakMemoryBytes());
+    }
+}
+
+// Sizes from 1K up to OPENSTL_BENCHMARK_MAX_TRIANGLES (default 1M), e.g.
+// OPENSTL_BENCHMARK_MAX_TRIANGLES=50000000 ./openstl_benchmarks "[sweep]"
+TEST_CASE("Throughput across mesh sizes", "[benchmark][sweep]") {
+    const std::string filename = (std::filesystem::temp_directory_path() / "openstl_sweep.bench.stl").string();
+
+    for (const size_t count : benchutils::sweepSizes()) {
+        std::vector<Triangle> triangles = benchutils::createGridTriangles(count);
+        const size_t memoryBytes = count * sizeof(Triangle);
+        const size_t binaryBytes = BINARY_STL_HEADER_SIZE + memoryBytes;
+        std::printf("\nmesh of %zu triangles (peak: resident memory of the process, input mesh included)\n", count);
+
+        measureCase("binary write", binaryBytes, count, [&] { writeBinaryStlFile(filename, triangles); });
+        measureCase("binary read", binaryBytes, count, [&] {
+            std::ifstream file(filename, std::ios::binary);
+            REQUIRE(deserializeBinaryStl(file).size() == count);
+        });
+
+        measureCase("ASCII write", memoryBytes, count, [&] {
+            std::ofstream file(filename, std::ios::binary);
+            serializeAsciiStl(triangles, file);
+        });
+        const auto asciiBytes = static_cast<size_t>(std::filesystem::file_size(filename));
+        measureCase("ASCII read", asciiBytes, count, [&] {
+            std::ifstream file(filename, std::ios::binary);
+            REQUIRE(deserializeAsciiStl(file).size() == count);
+        });
+
+        std::vector<Vec3> vertices;
+        std::vector<BasicFace<uint32_t>> faces;
+        measureCase("convertToVerticesAndFaces", memoryBytes, count, [&] {
+            std::tie(vertices, faces) = convertToVerticesAndFaces<uint32_t>(triangles);
+            REQUIRE(faces.size() == count);
+        });
+        // The conversions and components only need the indexed mesh from here on
+        std::vector<Triangle>{}.swap(triangles);
+
+        measureCase("convertToTriangles", memoryBytes, count, [&] {
+            REQUIRE(convertToTriangles(vertices, faces).size() == count);
+        });
+        measureCase("findConnectedComponents", faces.size() * sizeof(faces[0]), count, [&] {
+            REQUIRE(findConnectedComponents<uint32_t>(vertices, faces).size() == 1u);
+        });
+    }
+    std::remove(filename.c_str());
+}
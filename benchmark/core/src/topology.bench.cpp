@@ -0,0 +1,189 @@
+#include <catch2/catch_test_macros.hpp>
+#include "openstl/benchmark/benchutils.h"
+#include "openstl/core/stl.h"
+
+using namespace openstl;
+
+namespace {
+    // Reference implementation of the former recursive union-find with rank, kept as a baseline
+    class LegacyDisjointSet {
+        std::vector<size_t> parent;
+        std::vector<size_t> rank;
+
+    public:
+        explicit LegacyDisjointSet(size_t size) : parent(size), rank(size, 0) {
+            for (size_t i = 0; i < size; ++i) parent[i] = i;
+        }
+
+        size_t find(size_t x) {
+            if (parent[x] != x) parent[x] = find(parent[x]);
+            return parent[x];
+        }
+
+        void unite(size_t x, size_t y) {
+            size_t rootX = find(x), rootY = find(y);
+            if (rootX != rootY) {
+                if (rank[rootX] < rank[rootY]) parent[rootX] = rootY;
+                else if (rank[rootX] > rank[rootY]) parent[rootY] = rootX;
+                else {
+                    parent[rootY] = rootX;
+                    ++rank[rootX];
+                }
+            }
+        }
+    };
+
+    // Reference implementation of the former grouping through an unordered_map lookup per face
+    std::vector<std::vector<Face>> legacyFindConnectedComponents(const std::vector<Vec3>& vertices,
+                                                                 const std::vector<Face>& faces) {
+        LegacyDisjointSet ds{vertices.size()};
+        for (const auto& tri : faces) {
+            ds.unite(tri[0], tri[1]);
+            ds.unite(tri[0], tri[2]);
+        }
+        std::vector<std::vector<Face>> result;
+        std::unordered_map<size_t, size_t> rootToIndex;
+        for (const auto& tri : faces) {
+            size_t root = ds.find(tri[0]);
+            if (rootToIndex.find(root) == rootToIndex.end()) {
+                rootToIndex[root] = result.size();
+                result.emplace_back();
+            }
+            result[rootToIndex[root]].push_back(tri);
+        }
+        return result;
+    }
+
+    // Baseline grouping of the half-edges: a comparison sort of packed (min, max) vertex keys
+    size_t countEdgesBySortedKeys(const std::vector<Face>& faces) {
+        std::vector<std::pair<uint64_t, uint32_t>> keys(3 * faces.size());
+        for (size_t h = 0; h < keys.size(); ++h) {
+            const uint64_t a = faces[h / 3][h % 3], b = faces[h / 3][(h % 3 + 1) % 3];
+            keys[h] = {std::min(a, b) << 32u | std::max(a, b), static_cast<uint32_t>(h)};
+        }
+        std::sort(keys.begin(), keys.end());
+        size_t edges{0};
+        for (size_t i = 0; i < keys.size(); ++i) edges += i == 0 || keys[i].first != keys[i - 1].first;
+        return edges;
+    }
+
+    template<typename Sets>
+    size_t countRoots(Sets& sets, size_t size) {
+        size_t roots{0};
+        for (size_t i = 0; i < size; ++i) roots += sets.find(i) == i;
+        return roots;
+    }
+}
+
+TEST_CASE("Union-find throughput", "[benchmark][topology]") {
+    const size_t count = 4000000;
+    std::vector<Vec3> vertices;
+    std::vector<Face> faces;
+    std::tie(vertices, faces) = convertToVerticesAndFaces(benchutils::createGridTriangles(count));
+    const size_t size = vertices.size();
+    const size_t bytes = faces.size() * sizeof(Face);
+    std::printf("\nunion-find over the faces of a grid, %zu triangles, %zu vertices\n", count, size);
+
+    const double legacy = benchutils::measureMedian([&] {
+        LegacyDisjointSet sets{size};
+        for (const auto& face : faces) { sets.unite(face[0], face[1]); sets.unite(face[0], face[2]); }
+        REQUIRE(countRoots(sets, size) == 1);
+    }, 3);
+    benchutils::report("legacy recursive DisjointSet", legacy, bytes, count);
+
+    const double wide = benchutils::measureMedian([&] {
+        BasicDisjointSet<size_t> sets{size};
+        for (const auto& face : faces) { sets.unite(face[0], face[1]); sets.unite(face[0], face[2]); }
+        REQUIRE(countRoots(sets, size) == 1);
+    }, 3);
+    benchutils::report("BasicDisjointSet<size_t>", wide, bytes, count);
+
+    const double compact = benchutils::measureMedian([&] {
+        BasicDisjointSet<uint32_t> sets{size};
+        for (const auto& face : faces) {
+            sets.unite(static_cast<uint32_t>(face[0]), static_cast<uint32_t>(face[1]));
+            sets.unite(static_cast<uint32_t>(face[0]), static_cast<uint32_t>(face[2]));
+        }
+        REQUIRE(countRoots(sets, size) == 1);
+    }, 3);
+    benchutils::report("BasicDisjointSet<uint32_t>", compact, bytes, count);
+
+    for (const size_t numThreads : {2u, 4u, 0u}) {
+        const double concurrent = benchutils::measureMedian([&] {
+            BasicDisjointSet<uint32_t> sets{size};
+            detail::uniteFaceVertices(sets, faces, numThreads);
+            REQUIRE(countRoots(sets, size) == 1);
+        }, 3);
+        benchutils::report("uniteConcurrent, " + std::to_string(numThreads) + " threads", concurrent, bytes, count);
+    }
+
+    const double components = benchutils::measureMedian([&] {
+        REQUIRE(findConnectedComponents(vertices, faces).size() == 1);
+    }, 3);
+    benchutils::report("findConnectedComponents", components, bytes, count);
+}
+
+TEST_CASE("Connected component labelling throughput", "[benchmark][topology]") {
+    for (const bool soup : {false, true}) {
+        const size_t count = 2000000;
+        std::vector<Vec3> vertices;
+        std::vector<Face> faces;
+        std::tie(vertices, faces) = convertToVerticesAndFaces(
+                soup ? benchutils::createRandomTriangles(count) : benchutils::createGridTriangles(count));
+        const size_t components = soup ? count : 1u;
+        const size_t bytes = faces.size() * sizeof(Face);
+        std::printf("\nconnected components of a %s, %zu triangles, %zu components\n",
+                    soup ? "triangle soup" : "grid", count, components);
+
+        const double legacy = benchutils::measureMedian([&] {
+            REQUIRE(legacyFindConnectedComponents(vertices, faces).size() == components);
+        }, 3);
+        benchutils::report("legacy findConnectedComponents", legacy, bytes, count);
+
+        const double nested = benchutils::measureMedian([&] {
+            REQUIRE(findConnectedComponents(vertices, faces).size() == components);
+        }, 3);
+        benchutils::report("findConnectedComponents", nested, bytes, count);
+
+        const double labels = benchutils::measureMedian([&] {
+            REQUIRE(labelConnectedComponents(vertices, faces).component_count == components);
+        }, 3);
+        benchutils::report("labelConnectedComponents", labels, bytes, count);
+
+        const double grouped = benchutils::measureMedian([&] {
+            REQUIRE(groupByComponent(labelConnectedComponents(vertices, faces)).offsets.size() == components + 1u);
+        }, 3);
+        benchutils::report("labelConnectedComponents + groupByComponent", grouped, bytes, count);
+    }
+}
+
+TEST_CASE("Edge adjacency throughput", "[benchmark][topology]") {
+    const size_t count = 4000000;
+    std::vector<Vec3> vertices;
+    std::vector<Face> faces;
+    std::tie(vertices, faces) = convertToVerticesAndFaces(benchutils::createGridTriangles(count));
+    const size_t bytes = faces.size() * sizeof(Face);
+    const size_t edgeCount = buildEdgeAdjacency(vertices, faces).edgeCount();
+    std::printf("\nedge adjacency of a grid, %zu triangles, %zu edges\n", count, edgeCount);
+
+    const double sorted = benchutils::measureMedian([&] {
+        REQUIRE(countEdgesBySortedKeys(faces) == edgeCount);
+    }, 3);
+    benchutils::report("std::sort of packed edge keys", sorted, bytes, count);
+
+    const double built = benchutils::measureMedian([&] {
+        REQUIRE(buildEdgeAdjacency(vertices, faces).edgeCount() == edgeCount);
+    }, 3);
+    benchutils::report("buildEdgeAdjacency", built, bytes, count);
+
+    const double threaded = benchutils::measureMedian([&] {
+        REQUIRE(buildEdgeAdjacency(vertices, faces, 0).edgeCount() == edgeCount);
+    }, 3);
+    benchutils::report("buildEdgeAdjacency, one thread per core", threaded, bytes, count);
+
+    const auto adjacency = buildEdgeAdjacency(vertices, faces);
+    const double labelled = benchutils::measureMedian([&] {
+        REQUIRE(labelEdgeConnectedComponents(adjacency).component_count == 1u);
+    }, 3);
+    benchutils::report("labelEdgeConnectedComponents", labelled, bytes, count);
+}
@@ -0,0 +1,150 @@
+#ifndef OPENSTL_BENCHMARK_BENCHUTILS_H
+#define OPENSTL_BENCHMARK_BENCHUTILS_H
+#include "openstl/core/stl.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace openstl {
+    namespace benchutils {
+        /**
+         * @brief Time a callable: one warm-up run followed by repeated measured runs.
+         * @return The median duration of the measured runs, in seconds.
+         */
+        template<typename Function>
+        inline double measureMedian(Function&& fn, size_t repeats = 5) {
+            fn(); // Warm-up
+            std::vector<double> durations(repeats);
+            for (auto& duration : durations) {
+                const auto start = std::chrono::steady_clock::now();
+                fn();
+                duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            }
+            std::nth_element(durations.begin(), durations.begin() + repeats / 2, durations.end());
+            return durations[repeats / 2];
+        }
+
+        /**
+         * @brief Print one result line with the median time and the byte and triangle throughputs, followed by
+         * the peak resident set size when given.
+         */
+        inline void report(const std::string& name, double seconds, size_t bytes, size_t triangles,
+                           size_t peakBytes = 0) {
+            std::printf("%-48s %10.3f ms %10.1f MB/s %10.2f Mtri/s", name.c_str(), seconds * 1e3,
+                        static_cast<double>(bytes) / seconds / 1e6,
+                        static_cast<double>(triangles) / seconds / 1e6);
+            if (peakBytes != 0u) std::printf(" %10.1f MB peak", static_cast<double>(peakBytes) / 1e6);
+            std::printf("\n");
+        }
+
+        /**
+         * @brief Reset the peak resident set size to the current one. Only Linux supports it; elsewhere the
+         * peak covers the whole process.
+         */
+        inline void resetPeakMemory() {
+#if defined(__linux__)
+            std::ofstream("/proc/self/clear_refs") << "5";
+#endif
+        }
+
+        /**
+         * @brief The peak resident set size of the process in bytes, since the last resetPeakMemory where supported.
+         */
+        inline size_t peakMemoryBytes() {
+#if defined(__linux__)
+            std::ifstream status("/proc/self/status");
+            std::string line;
+            while (std::getline(status, line)) {
+                if (line.rfind("VmHWM:", 0) == 0) return std::stoull(line.substr(6)) * 1024u;
+            }
+            return 0u;
+#elif defined(_WIN32)
+            PROCESS_MEMORY_COUNTERS counters{};
+            GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+            return counters.PeakWorkingSetSize;
+#else
+            rusage usage{};
+            getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+            return static_cast<size_t>(usage.ru_maxrss); // Bytes on macOS
+#else
+            return static_cast<size_t>(usage.ru_maxrss) * 1024u;
+#endif
+#endif
+        }
+
+        /**
+         * @brief Mesh sizes of the size sweeps, from 1K to 50M triangles, up to the limit set by the
+         * OPENSTL_BENCHMARK_MAX_TRIANGLES environment variable (1M by default).
+         */
+        inline std::vector<size_t> sweepSizes() {
+            size_t limit = 1000000u;
+            if (const char* value = std::getenv("OPENSTL_BENCHMARK_MAX_TRIANGLES"))
+                limit = static_cast<size_t>(std::strtoull(value, nullptr, 10));
+            std::vector<size_t> sizes;
+            for (const size_t size : {1000u, 10000u, 100000u, 1000000u, 10000000u, 50000000u}) {
+                if (size <= limit) sizes.push_back(size);
+            }
+            return sizes;
+        }
+
+        /**
+         * @brief Repeat small cases more, so that each timed case lasts roughly as long: 9 runs up to 100K
+         * triangles, 5 up to 1M, then a single one.
+         */
+        inline size_t sweepRepeats(size_t triangles) {
+            return triangles <= 100000u ? 9u : triangles <= 1000000u ? 5u : 1u;
+        }
+
+        /**
+         * @brief Generate a deterministic soup of triangles with arbitrary coordinates.
+         */
+        inline std::vector<Triangle> createRandomTriangles(size_t count, unsigned seed = 42) {
+            std::mt19937 gen{seed};
+            std::uniform_real_distribution<float> dist{-1000.f, 1000.f};
+            std::vector<Triangle> triangles(count);
+            for (auto& tri : triangles) {
+                for (auto* v : {&tri.normal, &tri.v0, &tri.v1, &tri.v2})
+                    *v = {dist(gen), dist(gen), dist(gen)};
+                tri.attribute_byte_count = 0u;
+            }
+            return triangles;
+        }
+
+        /**
+         * @brief Generate a deterministic wavy grid surface, where inner vertices are shared by six triangles.
+         */
+        inline std::vector<Triangle> createGridTriangles(size_t count) {
+            const auto side = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(count) / 2.0))) + 1u;
+            auto vertex = [](size_t i, size_t j) {
+                const float x = static_cast<float>(i) * 0.5f, y = static_cast<float>(j) * 0.5f;
+                return Vec3{x, y, std::sin(x) * std::cos(y)};
+            };
+            std::vector<Triangle> triangles;
+            triangles.reserve(count);
+            for (size_t j = 0; j + 1 < side && triangles.size() < count; ++j) {
+                for (size_t i = 0; i + 1 < side && triangles.size() < count; ++i) {
+                    const Vec3 a = vertex(i, j), b = vertex(i + 1, j), c = vertex(i, j + 1), d = vertex(i + 1, j + 1);
+                    triangles.push_back(Triangle{crossProduct(b - a, c - a), a, b, c, 0u});
+                    if (triangles.size() < count)
+                        triangles.push_back(Triangle{crossProduct(b - c, d - c), c, b, d, 0u});
+                }
+            }
+            return triangles;
+        }
+    } //namespace benchutils
+} //namespace openstl
+#endif //OPENSTL_BENCHMARK_BENCHUTILS_H
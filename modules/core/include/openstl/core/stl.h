@@ -35,14 +35,51 @@ SOFTWARE.
 #include <cmath>
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
 #include <limits>
 #include <locale>
+#include <memory>
+#include <mutex>
+#include <new>
 #include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
-#define MAX_TRIANGLES 1000000
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+// Instruction set of the vectorized geometry kernels, selected at compile time
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define OPENSTL_SIMD_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define OPENSTL_SIMD_SSE2
+#endif
 
 namespace openstl
 {
@@ -58,57 +95,647 @@ namespace openstl
     };
 #pragma pack(pop)
 
+    //---------------------------------------------------------------------------------------------------------
+    // Parallel Utils
+    //---------------------------------------------------------------------------------------------------------
+
+    /**
+     * @brief Resolve a requested number of threads, 0 meaning one thread per hardware core.
+     */
+    inline std::size_t resolveThreadCount(std::size_t numThreads) noexcept {
+        if (numThreads != 0u) return numThreads;
+        const auto hardware = std::thread::hardware_concurrency();
+        return hardware != 0u ? hardware : 1u;
+    }
+
+    /**
+     * @brief Run task(i) for every i in [0, count) on a pool of worker threads.
+     *
+     * Indices are handed out dynamically and the calling thread takes part in the work. Once a task throws,
+     * no further index is handed out and the first exception is rethrown after every worker has joined.
+     *
+     * @param count The number of tasks.
+     * @param numThreads The maximum number of threads (0: one per hardware core).
+     * @param task The callable invoked with each index.
+     */
+    template<typename Task>
+    inline void parallelFor(std::size_t count, std::size_t numThreads, Task&& task) {
+        numThreads = std::min(resolveThreadCount(numThreads), count);
+        if (numThreads <= 1u) {
+            for (std::size_t i = 0; i < count; ++i) task(i);
+            return;
+        }
+
+        std::atomic<std::size_t> next{0};
+        std::exception_ptr error{};
+        std::mutex errorMutex;
+        auto worker = [&]() {
+            for (std::size_t i = next++; i < count; i = next++) {
+                try {
+                    task(i);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock{errorMutex};
+                    if (!error) error = std::current_exception();
+                    next = count;
+                    return;
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(numThreads - 1u);
+        for (std::size_t t = 1; t < numThreads; ++t) threads.emplace_back(worker);
+        worker();
+        for (auto& thread : threads) thread.join();
+        if (error) std::rethrow_exception(error);
+    }
+
+    namespace detail {
+        /** @brief Whether a container provides random access through operator[], as needed to split it in ranges. */
+        template<typename Container, typename = void>
+        struct IsIndexable : std::false_type {};
+
+        template<typename Container>
+        struct IsIndexable<Container, std::void_t<decltype(std::declval<const Container&>()[std::size_t{}])>>
+                : std::true_type {};
+    } //namespace detail
+
+    //---------------------------------------------------------------------------------------------------------
+    // Instrumentation
+    //---------------------------------------------------------------------------------------------------------
+
+    /**
+     * Opt-in timers and counters around the stages of reading, writing, conversion and topology, enabled by
+     * defining OPENSTL_ENABLE_INSTRUMENTATION (CMake option of the same name). Otherwise, the OPENSTL_TIMED_SCOPE,
+     * OPENSTL_COUNT and OPENSTL_COUNT_ALLOCATION macros expand to nothing and stats() stays empty.
+     */
+    namespace instrumentation {
+#ifdef OPENSTL_ENABLE_INSTRUMENTATION
+        constexpr bool ENABLED = true;
+#else
+        constexpr bool ENABLED = false;
+#endif
+
+        enum class Counter : std::size_t {
+            BytesRead, BytesWritten, TrianglesParsed, TrianglesWritten, HashProbes, Allocations, AllocatedBytes
+        };
+        constexpr std::size_t COUNTER_COUNT = 7;
+
+        /** @brief The snake_case name of a counter, as used in the Python dict and the Chrome trace. */
+        inline const char* counterName(Counter counter) noexcept {
+            static constexpr const char* names[COUNTER_COUNT] = {
+                    "bytes_read", "bytes_written", "triangles_parsed", "triangles_written", "hash_probes",
+                    "allocations", "allocated_bytes"};
+            return names[static_cast<std::size_t>(counter)];
+        }
+
+        /** @brief Aggregated durations of the scopes sharing a name. Nested scopes are included in their parent. */
+        struct TimerStats {
+            std::string name;
+            uint64_t calls{0};
+            double total_seconds{0.0};
+            double max_seconds{0.0};
+        };
+
+        /** @brief A snapshot of the counters and timers accumulated since the last reset. */
+        struct Stats {
+            std::array<uint64_t, COUNTER_COUNT> counters{};
+            std::vector<TimerStats> timers;
+            std::size_t dropped_events{0}; ///< Scopes timed but left out of the trace, past MAX_TRACE_EVENTS
+
+            uint64_t counter(Counter c) const noexcept { return counters[static_cast<std::size_t>(c)]; }
+        };
+
+        /** @brief The number of scopes kept for the Chrome trace; later ones are only aggregated. */
+        constexpr std::size_t MAX_TRACE_EVENTS = std::size_t{1} << 20u;
+
+        namespace detail {
+            struct TraceEvent {
+                const char* name;
+                uint64_t start_ns, duration_ns;
+                uint32_t thread;
+            };
+
+            class Registry {
+            public:
+                void add(Counter counter, uint64_t value) noexcept {
+                    counters_[static_cast<std::size_t>(counter)].fetch_add(value, std::memory_order_relaxed);
+                }
+
+                void record(const char* name, std::chrono::steady_clock::time_point start,
+                            std::chrono::steady_clock::time_point stop) noexcept {
+                    const auto startNs = static_cast<uint64_t>(
+                            std::chrono::duration_cast<std::chrono::nanoseconds>(start - epoch_).count());
+                    const auto durationNs = static_cast<uint64_t>(
+                            std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+                    const uint32_t thread = threadId();
+                    std::lock_guard<std::mutex> lock{mutex_};
+                    try {
+                        auto timer = std::find_if(timers_.begin(), timers_.end(), [name](const TimerStats& t) {
+                            return t.name == name;
+                        });
+                        if (timer == timers_.end()) timer = timers_.insert(timers_.end(), TimerStats{name});
+                        const double seconds = static_cast<double>(durationNs) * 1e-9;
+                        ++timer->calls;
+                        timer->total_seconds += seconds;
+                        timer->max_seconds = std::max(timer->max_seconds, seconds);
+                        if (events_.size() < MAX_TRACE_EVENTS) events_.push_back({name, startNs, durationNs, thread});
+                        else ++dropped_;
+                    } catch (...) {
+                        ++dropped_; // Out of memory: the scope is lost rather than failing the instrumented call
+                    }
+                }
+
+                Stats stats() const {
+                    Stats stats;
+                    for (std::size_t i = 0; i < COUNTER_COUNT; ++i)
+                        stats.counters[i] = counters_[i].load(std::memory_order_relaxed);
+                    std::lock_guard<std::mutex> lock{mutex_};
+                    stats.timers = timers_;
+                    stats.dropped_events = dropped_;
+                    return stats;
+                }
+
+                std::vector<TraceEvent> events() const {
+                    std::lock_guard<std::mutex> lock{mutex_};
+                    return events_;
+                }
+
+                void reset() {
+                    for (auto& counter : counters_) counter.store(0u, std::memory_order_relaxed);
+                    std::lock_guard<std::mutex> lock{mutex_};
+                    timers_.clear();
+                    events_.clear();
+                    dropped_ = 0u;
+                }
+
+            private:
+                /** @brief A small, stable identifier of the calling thread, for the trace. */
+                static uint32_t threadId() noexcept {
+                    static std::atomic<uint32_t> next{0};
+                    thread_local const uint32_t id = next++;
+                    return id;
+                }
+
+                std::array<std::atomic<uint64_t>, COUNTER_COUNT> counters_{};
+                const std::chrono::steady_clock::time_point epoch_ = std::chrono::steady_clock::now();
+                mutable std::mutex mutex_;
+                std::vector<TimerStats> timers_;
+                std::vector<TraceEvent> events_;
+                std::size_t dropped_{0};
+            };
+
+            inline Registry& registry() {
+                static Registry instance;
+                return instance;
+            }
+        } //namespace detail
+
+        /** @brief Add to a counter. Prefer OPENSTL_COUNT, which compiles to nothing when disabled. */
+        inline void add(Counter counter, uint64_t value) noexcept {
+            detail::registry().add(counter, value);
+        }
+
+        /** @brief The counters and timers accumulated since the last reset. */
+        inline Stats stats() {
+            return detail::registry().stats();
+        }
+
+        /** @brief Zero the counters and forget the timed scopes. */
+        inline void reset() {
+            detail::registry().reset();
+        }
+
+        /**
+         * @brief Write the timed scopes as a Chrome trace (chrome://tracing, Perfetto), one complete event per scope
+         * and thread, followed by the counters as a single counter event.
+         */
+        template<typename Stream>
+        void writeChromeTrace(Stream& stream) {
+            const auto events = detail::registry().events();
+            const Stats snapshot = stats();
+            char buffer[64];
+            auto microseconds = [&buffer](uint64_t ns) {
+                std::snprintf(buffer, sizeof(buffer), "%.3f", static_cast<double>(ns) * 1e-3);
+                return buffer;
+            };
+            stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+            uint64_t end{0};
+            for (const auto& event : events) {
+                stream << "\n{\"name\":\"" << event.name << "\",\"cat\":\"openstl\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+                       << event.thread << ",\"ts\":" << microseconds(event.start_ns);
+                stream << ",\"dur\":" << microseconds(event.duration_ns) << "},";
+                end = std::max(end, event.start_ns + event.duration_ns);
+            }
+            stream << "\n{\"name\":\"counters\",\"cat\":\"openstl\",\"ph\":\"C\",\"pid\":1,\"tid\":0,\"ts\":"
+                   << microseconds(end) << ",\"args\":{";
+            for (std::size_t i = 0; i < COUNTER_COUNT; ++i) {
+                stream << (i != 0u ? "," : "") << '"' << counterName(static_cast<Counter>(i)) << "\":"
+                       << snapshot.counters[i];
+            }
+            stream << "}}\n]}\n";
+        }
+
+        /** @brief The Chrome trace of writeChromeTrace, as a string. */
+        inline std::string chromeTrace() {
+            std::ostringstream stream;
+            writeChromeTrace(stream);
+            return stream.str();
+        }
+
+        /** @brief Time the enclosing scope under a name with static storage duration, e.g. a string literal. */
+        class ScopedTimer {
+        public:
+            explicit ScopedTimer(const char* name) noexcept : name_(name), start_(std::chrono::steady_clock::now()) {}
+            ScopedTimer(const ScopedTimer&) = delete;
+            ScopedTimer& operator=(const ScopedTimer&) = delete;
+            ~ScopedTimer() { detail::registry().record(name_, start_, std::chrono::steady_clock::now()); }
+
+        private:
+            const char* name_;
+            std::chrono::steady_clock::time_point start_;
+        };
+
+        /**
+         * @brief A plain counter for hot loops, added to a global counter on destruction. Copies start from zero.
+         * Compiles to an empty object when instrumentation is disabled.
+         */
+        class LocalCounter {
+        public:
+            explicit LocalCounter(Counter counter) noexcept
+#ifdef OPENSTL_ENABLE_INSTRUMENTATION
+                    : counter_(counter)
+#endif
+            { static_cast<void>(counter); }
+            LocalCounter(const LocalCounter& other) noexcept : LocalCounter(other.counter()) {}
+            LocalCounter& operator=(const LocalCounter&) noexcept { return *this; }
+#ifdef OPENSTL_ENABLE_INSTRUMENTATION
+            ~LocalCounter() { if (value_ != 0u) add(counter_, value_); }
+            LocalCounter& operator++() noexcept { ++value_; return *this; }
+            LocalCounter& operator+=(uint64_t value) noexcept { value_ += value; return *this; }
+            Counter counter() const noexcept { return counter_; }
+
+        private:
+            Counter counter_;
+            uint64_t value_{0};
+#else
+            LocalCounter& operator++() noexcept { return *this; }
+            LocalCounter& operator+=(uint64_t) noexcept { return *this; }
+            Counter counter() const noexcept { return Counter::BytesRead; }
+#endif
+        };
+    } //namespace instrumentation
+
+#define OPENSTL_INSTRUMENTATION_CONCAT_(a, b) a##b
+#define OPENSTL_INSTRUMENTATION_CONCAT(a, b) OPENSTL_INSTRUMENTATION_CONCAT_(a, b)
+#ifdef OPENSTL_ENABLE_INSTRUMENTATION
+#define OPENSTL_TIMED_SCOPE(name) \
+    const ::openstl::instrumentation::ScopedTimer OPENSTL_INSTRUMENTATION_CONCAT(openstlTimedScope, __LINE__){name}
+#define OPENSTL_COUNT(counter, value) \
+    ::openstl::instrumentation::add(::openstl::instrumentation::Counter::counter, static_cast<uint64_t>(value))
+#define OPENSTL_COUNT_ALLOCATION(bytes) \
+    (OPENSTL_COUNT(Allocations, 1u), OPENSTL_COUNT(AllocatedBytes, bytes))
+#else
+#define OPENSTL_TIMED_SCOPE(name) static_cast<void>(0)
+#define OPENSTL_COUNT(counter, value) static_cast<void>(0)
+#define OPENSTL_COUNT_ALLOCATION(bytes) static_cast<void>(0)
+#endif
+
     //---------------------------------------------------------------------------------------------------------
     // Serialize
     //---------------------------------------------------------------------------------------------------------
     enum class StlFormat { ASCII, Binary };
 
+    /** @brief Precision requesting the shortest representation that reads back to the same float. */
+    constexpr int SHORTEST_PRECISION = -1;
+
+    /** @brief The largest number of characters formatAsciiFacet writes for a single triangle. */
+    constexpr std::size_t ASCII_FACET_MAX_SIZE = 512;
+
+    /**
+     * @brief Format a float, locale-independently.
+     *
+     * @param out The destination, with room for at least 32 characters.
+     * @param value The value to format.
+     * @param precision SHORTEST_PRECISION for the shortest round-trip representation, otherwise the number of
+     * significant digits as with printf's %g (clamped to [1, 9], a float holding at most 9 significant digits).
+     * @return A pointer past the last character written.
+     */
+    inline char* formatFloat(char* out, float value, int precision) noexcept {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        constexpr std::size_t MAX_SIZE = 32;
+        const auto result = precision < 0
+                ? std::to_chars(out, out + MAX_SIZE, value)
+                : std::to_chars(out, out + MAX_SIZE, value, std::chars_format::general,
+                                std::min(std::max(precision, 1), 9));
+        return result.ptr;
+#else
+        // snprintf is locale-dependent for the decimal point, which the STL readers accept either way. Without
+        // shortest formatting, 9 significant digits are the least guaranteeing a round trip.
+        const int digits = precision < 0 ? 9 : std::min(std::max(precision, 1), 9);
+        return out + std::snprintf(out, 32, "%.*g", digits, static_cast<double>(value));
+#endif
+    }
+
+    /**
+     * @brief Format one triangle as an ASCII STL facet, from "facet normal" to "endfacet" included.
+     *
+     * @param out The destination, with room for at least ASCII_FACET_MAX_SIZE characters.
+     * @return A pointer past the last character written.
+     */
+    inline char* formatAsciiFacet(char* out, const Triangle& tri, int precision) noexcept {
+        auto append = [&out](std::string_view text) {
+            std::memcpy(out, text.data(), text.size());
+            out += text.size();
+        };
+        auto appendVec3 = [&](const Vec3& v) {
+            out = formatFloat(out, v.x, precision);
+            *out++ = ' ';
+            out = formatFloat(out, v.y, precision);
+            *out++ = ' ';
+            out = formatFloat(out, v.z, precision);
+            *out++ = '\n';
+        };
+        append("facet normal ");
+        appendVec3(tri.normal);
+        append("outer loop\n");
+        for (const auto* v : {&tri.v0, &tri.v1, &tri.v2}) {
+            append("vertex ");
+            appendVec3(*v);
+        }
+        append("endloop\nendfacet\n");
+        return out;
+    }
+
     /**
      * @brief Serialize a vector of triangles to an ASCII STL format and write it to the provided stream.
      *
      * This function writes the vector of triangles to the stream in ASCII STL format, where each triangle
-     * is represented by its normal vector and three vertices.
+     * is represented by its normal vector and three vertices. Facets are formatted into a reusable buffer,
+     * written to the stream in blocks of about bufferSize bytes.
      *
      * @tparam Stream The type of the output stream.
      * @param triangles The vector of triangles to serialize.
      * @param stream The output stream to write the serialized data to.
+     * @param precision SHORTEST_PRECISION (shortest round-trip representation) or a number of significant digits.
+     * @param bufferSize The size of the formatting buffer.
      */
     template<typename Stream, typename Container>
-    void serializeAsciiStl(const Container& triangles, Stream& stream) {
-        stream << "solid\n";
+    void serializeAsciiStl(const Container& triangles, Stream& stream, int precision = SHORTEST_PRECISION,
+                           std::size_t bufferSize = std::size_t{1} << 20u) {
+        OPENSTL_TIMED_SCOPE("serializeAsciiStl");
+        bufferSize = std::max(bufferSize, 2u * ASCII_FACET_MAX_SIZE);
+        std::unique_ptr<char[]> buffer{new char[bufferSize]};
+        char* const first = buffer.get();
+        char* const flushLimit = first + bufferSize - ASCII_FACET_MAX_SIZE;
+        char* out = first;
+        std::memcpy(out, "solid\n", 6);
+        out += 6;
         for (const auto& tri : triangles) {
-            stream << "facet normal " << tri.normal.x << " " << tri.normal.y << " " << tri.normal.z << std::endl;
-            stream << "outer loop" << std::endl;
-            stream << "vertex " << tri.v0.x << " " << tri.v0.y << " " << tri.v0.z << std::endl;
-            stream << "vertex " << tri.v1.x << " " << tri.v1.y << " " << tri.v1.z << std::endl;
-            stream << "vertex " << tri.v2.x << " " << tri.v2.y << " " << tri.v2.z << std::endl;
-            stream << "endloop" << std::endl;
-            stream << "endfacet" << std::endl;
+            out = formatAsciiFacet(out, tri, precision);
+            if (out > flushLimit) {
+                stream.write(first, static_cast<std::streamsize>(out - first));
+                OPENSTL_COUNT(BytesWritten, out - first);
+                out = first;
+            }
+        }
+        std::memcpy(out, "endsolid\n", 9);
+        out += 9;
+        stream.write(first, static_cast<std::streamsize>(out - first));
+        OPENSTL_COUNT(BytesWritten, out - first);
+        OPENSTL_COUNT(TrianglesWritten, triangles.size());
+    }
+
+    /**
+     * @brief Serialize triangles to an ASCII STL format on several threads, byte-for-byte identical to
+     * serializeAsciiStl.
+     *
+     * Consecutive ranges of triangles are formatted concurrently into per-range buffers, which are written to
+     * the stream in order, a round of a few ranges per thread at a time. Containers without operator[] are
+     * serialized by serializeAsciiStl.
+     *
+     * @param triangles The container of triangles to serialize.
+     * @param stream The output stream to write the serialized data to.
+     * @param numThreads The maximum number of threads (0: one per hardware core).
+     * @param precision SHORTEST_PRECISION (shortest round-trip representation) or a number of significant digits.
+     */
+    template<typename Stream, typename Container>
+    void serializeAsciiStlParallel(const Container& triangles, Stream& stream, std::size_t numThreads = 0,
+                                   int precision = SHORTEST_PRECISION) {
+        numThreads = resolveThreadCount(numThreads);
+        constexpr std::size_t CHUNK_SIZE = 4096; // Triangles per buffer
+        const std::size_t count = static_cast<std::size_t>(triangles.size());
+        if constexpr (!detail::IsIndexable<Container>::value) {
+            serializeAsciiStl(triangles, stream, precision);
+            return;
+        } else {
+            if (numThreads <= 1u || count <= CHUNK_SIZE) {
+                serializeAsciiStl(triangles, stream, precision);
+                return;
+            }
+            const std::size_t chunkCount = (count + CHUNK_SIZE - 1u) / CHUNK_SIZE;
+            const std::size_t roundSize = std::min(chunkCount, numThreads * 2u);
+            std::vector<std::unique_ptr<char[]>> buffers(roundSize);
+            std::vector<std::size_t> sizes(roundSize);
+            for (auto& buffer : buffers) buffer.reset(new char[CHUNK_SIZE * ASCII_FACET_MAX_SIZE]);
+            OPENSTL_COUNT_ALLOCATION(roundSize * CHUNK_SIZE * ASCII_FACET_MAX_SIZE);
+
+            OPENSTL_TIMED_SCOPE("serializeAsciiStlParallel");
+            stream.write("solid\n", 6);
+            for (std::size_t roundFirst = 0; roundFirst < chunkCount; roundFirst += roundSize) {
+                const std::size_t chunks = std::min(roundSize, chunkCount - roundFirst);
+                parallelFor(chunks, numThreads, [&](std::size_t i) {
+                    const std::size_t first = (roundFirst + i) * CHUNK_SIZE;
+                    const std::size_t last = std::min(count, first + CHUNK_SIZE);
+                    char* out = buffers[i].get();
+                    for (std::size_t t = first; t < last; ++t) out = formatAsciiFacet(out, triangles[t], precision);
+                    sizes[i] = static_cast<std::size_t>(out - buffers[i].get());
+                });
+                for (std::size_t i = 0; i < chunks; ++i) {
+                    stream.write(buffers[i].get(), static_cast<std::streamsize>(sizes[i]));
+                    OPENSTL_COUNT(BytesWritten, sizes[i]);
+                }
+            }
+            stream.write("endsolid\n", 9);
+            OPENSTL_COUNT(BytesWritten, 6u + 9u);
+            OPENSTL_COUNT(TrianglesWritten, count);
         }
-        stream << "endsolid\n";
     }
 
+    /** @brief Size of the 80-byte comment header followed by the 4-byte triangle count of a binary STL. */
+    constexpr std::size_t BINARY_STL_HEADER_SIZE = 84;
+
+    /** @brief Number of triangles staged at once when writing containers without contiguous storage (~1 MiB). */
+    constexpr std::size_t BINARY_STAGING_TRIANGLES = (std::size_t{1} << 20u) / sizeof(Triangle);
+
+    namespace detail {
+        /** @brief Whether a container stores its triangles contiguously, exposed through data(). */
+        template<typename Container, typename = void>
+        struct HasContiguousTriangles : std::false_type {};
+
+        template<typename Container>
+        struct HasContiguousTriangles<Container, std::enable_if_t<std::is_convertible<
+                decltype(std::declval<const Container&>().data()), const Triangle*>::value>> : std::true_type {};
+
+        /** @brief Whether a container stores its triangles contiguously and exposes them writable, through data(). */
+        template<typename Container, typename = void>
+        struct HasMutableContiguousTriangles : std::false_type {};
+
+        template<typename Container>
+        struct HasMutableContiguousTriangles<Container, std::enable_if_t<std::is_convertible<
+                decltype(std::declval<Container&>().data()), Triangle*>::value>> : std::true_type {};
+
+        /**
+         * @brief Distance in bytes between consecutive triangles of a container: its static STRIDE_BYTES member
+         * if any, e.g. 48 for views over rows of 12 floats without the attribute, sizeof(Triangle) otherwise.
+         */
+        template<typename Container, typename = void>
+        struct TriangleStride : std::integral_constant<std::size_t, sizeof(Triangle)> {};
+
+        template<typename Container>
+        struct TriangleStride<Container, std::void_t<decltype(Container::STRIDE_BYTES)>>
+                : std::integral_constant<std::size_t, Container::STRIDE_BYTES> {};
+
+        inline std::array<char, BINARY_STL_HEADER_SIZE> makeBinaryStlHeader(std::size_t triangleCount) {
+            std::array<char, BINARY_STL_HEADER_SIZE> header{}; // 80 bytes for comments, then the count
+            const char comment[] = "STL Exported by OpenSTL [https://github.com/Innoptech/OpenSTL]";
+            std::memcpy(header.data(), comment, sizeof(comment));
+            const auto count = static_cast<uint32_t>(triangleCount);
+            std::memcpy(header.data() + 80, &count, sizeof(count));
+            return header;
+        }
+
+        /**
+         * @brief Hand the raw payload of the triangles to sink(const char* data, size_t size): in a single call
+         * for contiguous storage, otherwise through a staging buffer of BINARY_STAGING_TRIANGLES triangles.
+         * Records narrower than a Triangle (see TriangleStride) are staged without reading past their end, with
+         * a zero attribute byte count.
+         */
+        template<typename Container, typename Sink>
+        inline void forEachBinaryBlock(const Container& triangles, Sink&& sink) {
+            const auto count = static_cast<std::size_t>(triangles.size());
+            if (count == 0u) return;
+            if constexpr (HasContiguousTriangles<Container>::value) {
+                sink(reinterpret_cast<const char*>(triangles.data()), count * sizeof(Triangle));
+            } else {
+                std::vector<Triangle> staging(std::min(count, BINARY_STAGING_TRIANGLES));
+                std::size_t staged{0};
+                for (const auto& tri : triangles) {
+                    if constexpr (TriangleStride<Container>::value < sizeof(Triangle)) {
+                        std::memcpy(&staging[staged], &tri, offsetof(Triangle, attribute_byte_count));
+                        staging[staged++].attribute_byte_count = 0u;
+                    } else {
+                        staging[staged++] = tri;
+                    }
+                    if (staged == staging.size()) {
+                        sink(reinterpret_cast<const char*>(staging.data()), staged * sizeof(Triangle));
+                        staged = 0;
+                    }
+                }
+                if (staged != 0u) sink(reinterpret_cast<const char*>(staging.data()), staged * sizeof(Triangle));
+            }
+        }
+    } //namespace detail
+
     /**
      * @brief Serialize a vector of triangles in binary STL format and write to a stream.
      *
+     * Contiguous triangle storage (a container whose data() returns const Triangle*) is written in a single
+     * call, other containers through a staging buffer of about 1 MiB.
+     *
      * @tparam Stream The type of the output stream.
      * @param triangles The vector of triangles to serialize.
      * @param stream The output stream to write the serialized data.
      */
     template<typename Stream, typename Container>
     void serializeBinaryStl(const Container& triangles, Stream& stream) {
-        // Write header (80 bytes for comments)
-        char header[80] = "STL Exported by OpenSTL [https://github.com/Innoptech/OpenSTL]";
-        stream.write(header, sizeof(header));
-
-        // Write triangle count (4 bytes)
-        auto triangleCount = static_cast<uint32_t>(triangles.size());
-        stream.write(reinterpret_cast<const char*>(&triangleCount), sizeof(triangleCount));
+        OPENSTL_TIMED_SCOPE("serializeBinaryStl");
+        const auto header = detail::makeBinaryStlHeader(static_cast<std::size_t>(triangles.size()));
+        stream.write(header.data(), static_cast<std::streamsize>(header.size()));
+        detail::forEachBinaryBlock(triangles, [&stream](const char* data, std::size_t size) {
+            stream.write(data, static_cast<std::streamsize>(size));
+        });
+        OPENSTL_COUNT(BytesWritten, header.size() + triangles.size() * sizeof(Triangle));
+        OPENSTL_COUNT(TrianglesWritten, triangles.size());
+    }
 
-        // Write triangles
-        for (const auto& tri : triangles) {
-            stream.write(reinterpret_cast<const char*>(&tri), sizeof(Triangle));
+    /**
+     * @brief Write triangles to a binary STL file through the operating system, bypassing iostreams.
+     *
+     * The header and contiguous triangle storage are written with a single vectored write (writev; WriteFile on
+     * Windows), other containers through a staging buffer of about 1 MiB.
+     *
+     * @param filename The path of the file to create or truncate.
+     * @param triangles The container of triangles to serialize.
+     * @throws std::runtime_error if the file cannot be opened or written.
+     */
+    template<typename Container>
+    void writeBinaryStlFile(const std::string& filename, const Container& triangles) {
+        OPENSTL_TIMED_SCOPE("writeBinaryStlFile");
+        const auto header = detail::makeBinaryStlHeader(static_cast<std::size_t>(triangles.size()));
+#ifdef _WIN32
+        HANDLE file = CreateFileA(filename.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                                  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("Unable to open file '" + filename + "' for writing.");
+        }
+        auto writeAll = [&](const char* data, std::size_t size) {
+            while (size != 0u) {
+                DWORD written{0};
+                const auto chunk = static_cast<DWORD>(std::min<std::size_t>(size, std::size_t{1} << 30u));
+                if (!WriteFile(file, data, chunk, &written, nullptr) || written == 0) {
+                    CloseHandle(file);
+                    throw std::runtime_error("Failed to write to file '" + filename + "'.");
+                }
+                data += written;
+                size -= written;
+            }
+        };
+        writeAll(header.data(), header.size());
+        detail::forEachBinaryBlock(triangles, writeAll);
+        if (!CloseHandle(file)) {
+            throw std::runtime_error("Failed to write to file '" + filename + "'.");
+        }
+#else
+        const int fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            throw std::runtime_error("Unable to open file '" + filename + "' for writing.");
+        }
+        // Write every buffer entirely, resuming after partial writes and interruptions
+        auto writeAll = [&](iovec* buffers, int count) {
+            while (count > 0) {
+                const ssize_t written = ::writev(fd, buffers, count);
+                if (written < 0 && errno == EINTR) continue;
+                if (written <= 0) {
+                    ::close(fd);
+                    throw std::runtime_error("Failed to write to file '" + filename + "'.");
+                }
+                auto remaining = static_cast<std::size_t>(written);
+                for (; count > 0 && remaining >= buffers->iov_len; ++buffers, --count) remaining -= buffers->iov_len;
+                if (count > 0) {
+                    buffers->iov_base = static_cast<char*>(buffers->iov_base) + remaining;
+                    buffers->iov_len -= remaining;
+                }
+            }
+        };
+        iovec buffers[2] = {{const_cast<char*>(header.data()), header.size()}, {nullptr, 0}};
+        if constexpr (detail::HasContiguousTriangles<Container>::value) {
+            // Header and payload in a single system call
+            buffers[1] = {const_cast<Triangle*>(triangles.data()), static_cast<std::size_t>(triangles.size()) * sizeof(Triangle)};
+            writeAll(buffers, buffers[1].iov_len != 0u ? 2 : 1);
+        } else {
+            writeAll(buffers, 1);
+            detail::forEachBinaryBlock(triangles, [&](const char* data, std::size_t size) {
+                iovec block{const_cast<char*>(data), size};
+                writeAll(&block, 1);
+            });
         }
+        if (::close(fd) != 0) {
+            throw std::runtime_error("Failed to write to file '" + filename + "'.");
+        }
+#endif
+        OPENSTL_COUNT(BytesWritten, header.size() + triangles.size() * sizeof(Triangle));
+        OPENSTL_COUNT(TrianglesWritten, triangles.size());
     }
 
 
@@ -137,12 +764,36 @@ namespace openstl
     //---------------------------------------------------------------------------------------------------------
 
     /**
-     * A library-level configuration to activate/deactivate the buffer overflow safety
-     * @return
+     * @brief Admission limits of a read, checked before the triangles are allocated.
+     *
+     * The triangle count of a binary header is always checked against the size of the stream first, so that a
+     * hostile header cannot trigger a large allocation. Both limits are unlimited by default: set them to bound
+     * the memory a single read may take, e.g. in a service reading untrusted files.
      */
-    inline bool& activateOverflowSafety() {
-        static bool safety_enabled = true;
-        return safety_enabled;
+    struct ReadOptions {
+        std::size_t max_triangles{std::numeric_limits<std::size_t>::max()}; ///< Maximum number of triangles.
+        std::size_t memory_budget{std::numeric_limits<std::size_t>::max()}; ///< Maximum bytes of triangles.
+
+        /** @brief The largest triangle count admitted by both limits. */
+        std::size_t triangleLimit() const noexcept {
+            return std::min(max_triangles, memory_budget / sizeof(Triangle));
+        }
+    };
+
+    namespace detail {
+        /**
+         * @brief Reject a triangle count exceeding the limits of a read.
+         *
+         * @throws std::runtime_error If the count exceeds max_triangles or its triangles the memory budget.
+         */
+        inline void admitTriangles(std::size_t count, const ReadOptions& options) {
+            if (count > options.max_triangles) {
+                throw std::runtime_error("Triangle count exceeds the maximum allowable value.");
+            }
+            if (count > options.memory_budget / sizeof(Triangle)) {
+                throw std::runtime_error("Triangle data exceeds the memory budget of the read.");
+            }
+        }
     }
 
     /**
@@ -166,10 +817,10 @@ namespace openstl
      */
     inline bool istarts_with(std::string_view hay, std::string_view needle) noexcept {
         if (hay.size() < needle.size()) return false;
+        // ASCII-only folding: keywords are plain ASCII and this avoids locale lookups on the parsing hot path
+        auto lower = [](char c) { return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c; };
         for (size_t i = 0; i < needle.size(); ++i) {
-            const auto a = std::tolower(static_cast<unsigned char>(hay[i]));
-            const auto b = std::tolower(static_cast<unsigned char>(needle[i]));
-            if (a != b) return false;
+            if (lower(hay[i]) != lower(needle[i])) return false;
         }
         return true;
     }
@@ -193,10 +844,130 @@ namespace openstl
         return out;
     }
 
+    /**
+     * @brief Whitespace test for the ASCII STL grammar (space, tab, CR, LF, VT, FF), independent of the locale.
+     */
+    inline bool isAsciiSpace(char c) noexcept {
+        return c == ' ' || (c >= '\t' && c <= '\r');
+    }
+
+    /**
+     * @brief Skip ASCII whitespace in [first, last).
+     *
+     * @return Pointer to the first non-whitespace character, or last.
+     */
+    inline const char* skipAsciiSpace(const char* first, const char* last) noexcept {
+        while (first != last && isAsciiSpace(*first)) ++first;
+        return first;
+    }
+
+    /**
+     * @brief Trim leading ASCII whitespace from a string_view, independently of the locale.
+     */
+    inline std::string_view ltrimAscii(std::string_view sv) noexcept {
+        const char* first = skipAsciiSpace(sv.data(), sv.data() + sv.size());
+        return sv.substr(static_cast<std::size_t>(first - sv.data()));
+    }
+
+    /**
+     * @brief Parse a float at the beginning of [first, last), without allocating.
+     *
+     * Accepts an optional sign, decimal and scientific notation, and always uses '.' as the decimal separator
+     * regardless of the global locale. Parsing stops at the first character that cannot extend the number.
+     *
+     * @param first Beginning of the characters to parse.
+     * @param last End of the characters to parse.
+     * @param value Output float.
+     * @return Pointer past the parsed number, or nullptr if no valid float could be parsed.
+     */
+    inline const char* parseFloat(const char* first, const char* last, float& value) noexcept {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        // std::from_chars does not accept an explicit '+' sign
+        if (first != last && *first == '+') {
+            ++first;
+            if (first != last && *first == '-') return nullptr;
+        }
+        const auto result = std::from_chars(first, last, value, std::chars_format::general);
+        if (result.ec != std::errc{}) return nullptr;
+        return result.ptr;
+#else
+        // Portable fallback: accumulate up to 19 significant digits and scale them in double precision
+        static constexpr double exactPowers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                                 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+        const char* p = first;
+        bool negative{false};
+        if (p != last && (*p == '+' || *p == '-')) negative = (*p++ == '-');
+
+        uint64_t mantissa{0};
+        int digits{0}, exponent{0};
+        bool anyDigit{false};
+        for (; p != last && *p >= '0' && *p <= '9'; ++p, anyDigit = true) {
+            if (digits < 19) {
+                mantissa = mantissa * 10u + static_cast<uint64_t>(*p - '0');
+                if (mantissa != 0u) ++digits;
+            } else {
+                ++exponent;
+            }
+        }
+        if (p != last && *p == '.') {
+            for (++p; p != last && *p >= '0' && *p <= '9'; ++p, anyDigit = true) {
+                if (digits < 19) {
+                    mantissa = mantissa * 10u + static_cast<uint64_t>(*p - '0');
+                    if (mantissa != 0u) ++digits;
+                    --exponent;
+                }
+            }
+        }
+        if (!anyDigit) return nullptr;
+
+        if (p != last && (*p == 'e' || *p == 'E')) {
+            const char* q = p + 1;
+            bool negativeExponent{false};
+            if (q != last && (*q == '+' || *q == '-')) negativeExponent = (*q++ == '-');
+            if (q != last && *q >= '0' && *q <= '9') {
+                int e{0};
+                for (; q != last && *q >= '0' && *q <= '9'; ++q) {
+                    if (e < 100000) e = e * 10 + (*q - '0');
+                }
+                exponent += negativeExponent ? -e : e;
+                p = q;
+            }
+        }
+
+        double result = static_cast<double>(mantissa);
+        if (mantissa != 0u) {
+            if (exponent >= 0 && exponent <= 22) result *= exactPowers[exponent];
+            else if (exponent < 0 && exponent >= -22) result /= exactPowers[-exponent];
+            else result *= std::pow(10.0, exponent);
+        }
+        // Values from FLT_MAX + half an ulp up would round to infinity
+        if (result >= static_cast<double>(std::numeric_limits<float>::max()) + std::ldexp(1.0, 103)) return nullptr;
+        value = static_cast<float>(negative ? -result : result);
+        return p;
+#endif
+    }
+
+    /**
+     * @brief Parse three whitespace-separated floats at the beginning of a string view.
+     *
+     * Trailing characters after the third float are ignored.
+     *
+     * @return True on success.
+     */
+    inline bool parseThreeFloats(std::string_view text, float& a, float& b, float& c) noexcept {
+        const char* last = text.data() + text.size();
+        const char* p = skipAsciiSpace(text.data(), last);
+        if ((p = parseFloat(p, last, a)) == nullptr) return false;
+        p = skipAsciiSpace(p, last);
+        if ((p = parseFloat(p, last, b)) == nullptr) return false;
+        p = skipAsciiSpace(p, last);
+        return parseFloat(p, last, c) != nullptr;
+    }
+
     /**
      * @brief Parse three floats from a line after a given ASCII STL keyword.
      *
-     * Accepts scientific notation; uses C locale for numeric parsing.
+     * Accepts scientific notation; numeric parsing is locale-independent.
      *
      * @param line Input line (whitespace tolerated).
      * @param keyword Expected leading keyword ("facet normal" or "vertex").
@@ -214,12 +985,7 @@ namespace openstl
         if (!istarts_with(line, keyword)) {
             throw std::runtime_error("Expected keyword '" + std::string(keyword) + "' not found.");
         }
-        std::string_view rest = ltrim(line.substr(keyword.size()));
-
-        // Use classic C locale to ensure '.' and scientific notation work regardless of global locale.
-        std::istringstream iss{std::string(rest)};
-        iss.imbue(std::locale::classic());
-        if (!(iss >> a >> b >> c)) {
+        if (!parseThreeFloats(line.substr(keyword.size()), a, b, c)) {
             throw std::runtime_error("Failed to parse three floats after '" + std::string(keyword) + "'.");
         }
     }
@@ -242,108 +1008,507 @@ namespace openstl
     }
 
     /**
-     * @brief Deserialize triangles from an ASCII STL input stream.
-     *
-     * Supports scientific notation and variable whitespace.
-     * Ignores unrelated lines (endfacet/endsolid/comments).
+     * @brief Split a contiguous block of characters into lines, without copying.
      *
-     * @tparam Stream Input stream type.
-     * @param stream Stream containing ASCII STL data.
-     * @param max_triangles Optional safety bound (default: unlimited).
+     * Lines are terminated by '\n'; a trailing '\r' is left in the line and treated as whitespace by the parser.
+     */
+    class BufferLineReader {
+    public:
+        BufferLineReader(const char* first, const char* last, std::size_t firstLineNumber = 1) noexcept
+                : pos_(first), last_(last), lineNumber_(firstLineNumber - 1) {}
+
+        /**
+         * @brief Fetch the next line.
+         * @return False once the buffer is exhausted.
+         */
+        bool next(std::string_view& line) noexcept {
+            if (pos_ == last_) return false;
+            const auto* eol = static_cast<const char*>(std::memchr(pos_, '\n', static_cast<std::size_t>(last_ - pos_)));
+            const char* end = eol != nullptr ? eol : last_;
+            line = std::string_view(pos_, static_cast<std::size_t>(end - pos_));
+            pos_ = eol != nullptr ? eol + 1 : last_;
+            ++lineNumber_;
+            return true;
+        }
+
+        /** @brief The 1-based number of the last line returned by next(). */
+        std::size_t lineNumber() const noexcept { return lineNumber_; }
+
+        /** @brief Position right after the last line returned by next(). */
+        const char* position() const noexcept { return pos_; }
+
+    private:
+        const char* pos_;
+        const char* last_;
+        std::size_t lineNumber_;
+    };
+
+    /**
+     * @brief Split a stream into lines through large block reads into a reusable buffer.
      *
-     * @return Vector of parsed triangles.
+     * Avoids the per-line allocation of std::getline. The buffer only grows if a single line exceeds it.
      *
-     * @throws std::runtime_error On malformed geometry or size overflow.
+     * @tparam Stream Input stream type.
      */
     template <typename Stream>
-    inline std::vector<Triangle> deserializeAsciiStl(
-            Stream& stream,
-            std::size_t max_triangles = std::numeric_limits<std::size_t>::max())
-    {
-        std::vector<Triangle> tris;
-        std::string raw;
+    class StreamLineReader {
+    public:
+        static constexpr std::size_t DEFAULT_CHUNK_SIZE = 1u << 20;
 
-        while (std::getline(stream, raw)) {
-            std::string_view line = ltrim(std::string_view(raw));
+        explicit StreamLineReader(Stream& stream, std::size_t chunkSize = DEFAULT_CHUNK_SIZE)
+                : stream_(stream), buffer_(new char[chunkSize]), capacity_(chunkSize) {}
 
-            if (!istarts_with(line, "facet normal")) {
-                // Tolerate other lines (solid/endsolid/endfacet/endloop/comments).
-                continue;
+        /**
+         * @brief Fetch the next line. The view stays valid until the next call.
+         * @return False once the stream is exhausted.
+         */
+        bool next(std::string_view& line) {
+            for (;;) {
+                const char* first = buffer_.get() + begin_;
+                const auto* eol = static_cast<const char*>(std::memchr(first, '\n', end_ - begin_));
+                if (eol != nullptr) {
+                    line = std::string_view(first, static_cast<std::size_t>(eol - first));
+                    begin_ += line.size() + 1;
+                    ++lineNumber_;
+                    return true;
+                }
+                if (eof_) {
+                    if (begin_ == end_) return false;
+                    line = std::string_view(first, end_ - begin_);
+                    begin_ = end_;
+                    ++lineNumber_;
+                    return true;
+                }
+                refill();
             }
+        }
 
-            Triangle t{};
-            parse_three_floats_after(line, "facet normal", t.normal.x, t.normal.y, t.normal.z);
-
-            // Read and optionally validate the 'outer loop' line.
-            const std::string outer = getline_or_throw(stream, "'outer loop'");
-            // If you want strictness, uncomment:
-            // if (!istarts_with(ltrim(std::string_view(outer)), "outer loop")) {
-            //     throw std::runtime_error("Expected 'outer loop' after 'facet normal'.");
-            // }
-
-            // Three vertices
-            readVertex(stream, t.v0);
-            readVertex(stream, t.v1);
-            readVertex(stream, t.v2);
+        /** @brief The 1-based number of the last line returned by next(). */
+        std::size_t lineNumber() const noexcept { return lineNumber_; }
 
-            tris.push_back(t);
-            if (tris.size() > max_triangles) {
-                throw std::runtime_error("Triangle count exceeds the maximum allowable value.");
+    private:
+        void refill() {
+            // Keep the pending partial line at the front of the buffer, growing it if the line fills it entirely
+            const std::size_t pending = end_ - begin_;
+            if (pending == capacity_) {
+                std::unique_ptr<char[]> larger(new char[capacity_ * 2]);
+                std::memcpy(larger.get(), buffer_.get(), pending);
+                buffer_ = std::move(larger);
+                capacity_ *= 2;
+            } else if (begin_ != 0u && pending != 0u) {
+                std::memmove(buffer_.get(), buffer_.get() + begin_, pending);
             }
+            begin_ = 0;
+            end_ = pending;
+
+            const auto requested = static_cast<std::streamsize>(capacity_ - end_);
+            stream_.read(buffer_.get() + end_, requested);
+            const auto received = stream_.gcount();
+            OPENSTL_COUNT(BytesRead, received);
+            end_ += static_cast<std::size_t>(received);
+            if (received < requested) eof_ = true;
         }
 
-        return tris;
-    }
+        Stream& stream_;
+        std::unique_ptr<char[]> buffer_;
+        std::size_t capacity_;
+        std::size_t begin_{0}, end_{0};
+        std::size_t lineNumber_{0};
+        bool eof_{false};
+    };
 
     /**
-     * @brief Deserialize a binary STL file from a stream and convert it to a vector of triangles.
+     * @brief Incremental ASCII STL parser pulling lines from a line reader.
      *
-     * @tparam Stream The type of the input stream.
-     * @param stream The input stream from which to read the binary STL data.
-     * @return A vector of triangles representing the geometry from the binary STL file.
+     * Supports scientific notation, variable whitespace and case-insensitive keywords.
+     * Ignores unrelated lines (solid/endsolid/endfacet/endloop/comments). Errors report the offending line number.
+     *
+     * @tparam LineReader A BufferLineReader or a StreamLineReader.
      */
-    template <typename Stream>
-    std::vector<Triangle> deserializeBinaryStl(Stream& stream) {
-        auto start_pos = stream.tellg();
-        stream.seekg(0, std::ios::end);
-        auto end_pos = stream.tellg();
-        stream.seekg(start_pos);
+    template <typename LineReader>
+    class AsciiStlParser {
+    public:
+        explicit AsciiStlParser(LineReader& lines) : lines_(lines) {}
 
-        if (end_pos - start_pos < 84) {
-            throw std::runtime_error("File is too small to be a valid STL file.");
+        /**
+         * @brief Parse the next facet.
+         *
+         * @param t Output triangle (the attribute byte count is set to 0).
+         * @return False once the input is exhausted.
+         *
+         * @throws std::runtime_error On malformed geometry or unexpected end of input.
+         */
+        bool next(Triangle& t) {
+            std::string_view line;
+            while (lines_.next(line)) {
+                line = ltrimAscii(line);
+                if (!istarts_with(line, "facet normal")) {
+                    // Tolerate other lines (solid/endsolid/endfacet/endloop/comments).
+                    continue;
+                }
+                parseFacet(line, t);
+                return true;
+            }
+            return false;
         }
 
-        char header[80];
-        stream.read(header, sizeof(header));
+        /**
+         * @brief Parse a facet given its (left-trimmed) 'facet normal' line, consuming the four lines that follow.
+         *
+         * @throws std::runtime_error On malformed geometry or unexpected end of input.
+         */
+        void parseFacet(std::string_view facetLine, Triangle& t) {
+            parseAfter(facetLine, "facet normal", t.normal);
 
-        if (stream.gcount() != sizeof(header)) {
-            throw std::runtime_error("Failed to read the full header. Possible corruption or incomplete file.");
+            // The 'outer loop' line is consumed but not validated
+            nextLine("'outer loop'");
+
+            // Three vertices
+            parseAfter(ltrimAscii(nextLine("vertex line")), "vertex", t.v0);
+            parseAfter(ltrimAscii(nextLine("vertex line")), "vertex", t.v1);
+            parseAfter(ltrimAscii(nextLine("vertex line")), "vertex", t.v2);
+            t.attribute_byte_count = 0u;
         }
 
-        uint32_t triangle_qty;
-        stream.read(reinterpret_cast<char*>(&triangle_qty), sizeof(triangle_qty));
+    private:
 
-        if (stream.gcount() != sizeof(triangle_qty) || stream.fail() || stream.eof()) {
-            throw std::runtime_error("Failed to read the triangle count. Possible corruption or incomplete file.");
+        std::string_view nextLine(const char* context) {
+            std::string_view line;
+            if (!lines_.next(line)) {
+                throw std::runtime_error(std::string("Unexpected end of stream while reading ") + context
+                                         + " after line " + std::to_string(lines_.lineNumber()) + ".");
+            }
+            return line;
         }
 
-        // Apply the triangle count limit only if activateOverflowSafety is true
-        if (activateOverflowSafety() && triangle_qty > MAX_TRIANGLES) {
-            throw std::runtime_error("Triangle count exceeds the maximum allowable value.");
+        void parseAfter(std::string_view line, std::string_view keyword, Vec3& v) const {
+            if (!istarts_with(line, keyword)) {
+                throw std::runtime_error("Expected keyword '" + std::string(keyword) + "' not found at line "
+                                         + std::to_string(lines_.lineNumber()) + ".");
+            }
+            if (!parseThreeFloats(line.substr(keyword.size()), v.x, v.y, v.z)) {
+                throw std::runtime_error("Failed to parse three floats after '" + std::string(keyword)
+                                         + "' at line " + std::to_string(lines_.lineNumber()) + ".");
+            }
         }
 
-        std::size_t expected_data_size = sizeof(Triangle) * triangle_qty;
+        LineReader& lines_;
+    };
 
-        if (end_pos - stream.tellg() < static_cast<std::streamoff>(expected_data_size)) {
+    /**
+     * @brief Parse every facet provided by a line reader.
+     *
+     * @tparam LineReader A BufferLineReader or a StreamLineReader.
+     * @param lines The line reader.
+     * @param max_triangles Safety bound on the number of triangles.
+     * @return Vector of parsed triangles.
+     *
+     * @throws std::runtime_error On malformed geometry or size overflow.
+     */
+    template <typename LineReader>
+    inline std::vector<Triangle> parseAsciiStl(LineReader& lines, std::size_t max_triangles)
+    {
+        OPENSTL_TIMED_SCOPE("parseAsciiStl");
+        AsciiStlParser<LineReader> parser{lines};
+        std::vector<Triangle> tris;
+        Triangle t{};
+        while (parser.next(t)) {
+            tris.push_back(t);
+            if (tris.size() > max_triangles) {
+                throw std::runtime_error("Triangle count exceeds the maximum allowable value.");
+            }
+        }
+        OPENSTL_COUNT(TrianglesParsed, tris.size());
+        return tris;
+    }
+
+    /**
+     * @brief Deserialize triangles from an ASCII STL input stream.
+     *
+     * Supports scientific notation and variable whitespace.
+     * Ignores unrelated lines (endfacet/endsolid/comments).
+     * The stream is consumed through large block reads; no allocation happens per line.
+     *
+     * @tparam Stream Input stream type.
+     * @param stream Stream containing ASCII STL data.
+     * @param max_triangles Optional safety bound (default: unlimited).
+     *
+     * @return Vector of parsed triangles.
+     *
+     * @throws std::runtime_error On malformed geometry or size overflow.
+     */
+    template <typename Stream>
+    inline std::vector<Triangle> deserializeAsciiStl(
+            Stream& stream,
+            std::size_t max_triangles = std::numeric_limits<std::size_t>::max())
+    {
+        StreamLineReader<Stream> lines{stream};
+        return parseAsciiStl(lines, max_triangles);
+    }
+
+    /**
+     * @brief Deserialize triangles from ASCII STL data held in a contiguous block of memory.
+     *
+     * Suited for memory-mapped files (see MappedFile) or data already loaded in memory.
+     *
+     * @param data Beginning of the ASCII STL data.
+     * @param size Size of the data in bytes.
+     * @param max_triangles Optional safety bound (default: unlimited).
+     *
+     * @return Vector of parsed triangles.
+     *
+     * @throws std::runtime_error On malformed geometry or size overflow.
+     */
+    inline std::vector<Triangle> deserializeAsciiStlBuffer(
+            const char* data, std::size_t size,
+            std::size_t max_triangles = std::numeric_limits<std::size_t>::max())
+    {
+        BufferLineReader lines{data, data + size};
+        return parseAsciiStl(lines, max_triangles);
+    }
+
+    /**
+     * @brief Deserialize ASCII STL data held in a contiguous block of memory, on multiple threads.
+     *
+     * The buffer is split at 'facet normal' line boundaries and the chunks are parsed concurrently into
+     * per-chunk triangle arrays, concatenated in order. The result, the max_triangles limit and the reported
+     * errors (including the offending line number) are identical to deserializeAsciiStlBuffer.
+     *
+     * @param data Beginning of the ASCII STL data.
+     * @param size Size of the data in bytes.
+     * @param max_triangles Optional safety bound (default: unlimited).
+     * @param numThreads Number of threads (0: one per hardware core).
+     *
+     * @return Vector of parsed triangles.
+     *
+     * @throws std::runtime_error On malformed geometry or size overflow.
+     */
+    inline std::vector<Triangle> deserializeAsciiStlBufferParallel(
+            const char* data, std::size_t size,
+            std::size_t max_triangles = std::numeric_limits<std::size_t>::max(),
+            std::size_t numThreads = 0)
+    {
+        constexpr std::size_t MIN_CHUNK_SIZE = 1u << 18;
+        numThreads = resolveThreadCount(numThreads);
+        const std::size_t targetCount = std::min(numThreads * 4u, size / MIN_CHUNK_SIZE);
+        if (numThreads <= 1u || targetCount <= 1u) {
+            return deserializeAsciiStlBuffer(data, size, max_triangles);
+        }
+        OPENSTL_TIMED_SCOPE("deserializeAsciiStlBufferParallel");
+        const char* last = data + size;
+
+        // Move each evenly spaced target to the next 'facet normal' line. The search stops at the next target,
+        // so that the whole pass stays linear even when no facet is found.
+        std::vector<const char*> targets(targetCount + 1u);
+        for (std::size_t i = 0; i <= targetCount; ++i) targets[i] = data + size * i / targetCount;
+        std::vector<const char*> boundaries(targetCount, nullptr);
+        boundaries[0] = data;
+        parallelFor(targetCount - 1u, numThreads, [&](std::size_t j) {
+            const std::size_t i = j + 1u;
+            const char* p = targets[i];
+            if (p[-1] != '\n') {
+                const auto* eol = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(last - p)));
+                p = eol != nullptr ? eol + 1 : last;
+            }
+            while (p < targets[i + 1u]) {
+                const auto* eol = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(last - p)));
+                const char* end = eol != nullptr ? eol : last;
+                if (istarts_with(ltrimAscii(std::string_view(p, static_cast<std::size_t>(end - p))), "facet normal")) {
+                    boundaries[i] = p;
+                    return;
+                }
+                p = eol != nullptr ? eol + 1 : last;
+            }
+        });
+        boundaries.erase(std::remove(boundaries.begin(), boundaries.end(), nullptr), boundaries.end());
+        boundaries.push_back(last);
+        const std::size_t chunkCount = boundaries.size() - 1u;
+
+        // First line number of each chunk
+        std::vector<std::size_t> firstLines(chunkCount, 1u);
+        parallelFor(chunkCount - 1u, numThreads, [&](std::size_t i) {
+            firstLines[i + 1u] = static_cast<std::size_t>(std::count(boundaries[i], boundaries[i + 1u], '\n'));
+        });
+        for (std::size_t i = 1; i < chunkCount; ++i) firstLines[i] += firstLines[i - 1u];
+
+        struct Chunk {
+            std::vector<Triangle> triangles;
+            std::exception_ptr error;
+            const char* consumedEnd{nullptr};
+            std::size_t nextLine{0};
+        };
+        std::vector<Chunk> chunks(chunkCount);
+
+        // A chunk owns the facets whose 'facet normal' line starts in [begin, end); a facet body may extend past end.
+        auto parseChunk = [&](Chunk& chunk, const char* begin, const char* end, std::size_t firstLine) {
+            chunk.triangles.clear();
+            chunk.error = nullptr;
+            BufferLineReader lines{begin, last, firstLine};
+            AsciiStlParser<BufferLineReader> parser{lines};
+            try {
+                std::string_view line;
+                Triangle t{};
+                while (lines.position() < end && lines.next(line)) {
+                    line = ltrimAscii(line);
+                    if (!istarts_with(line, "facet normal")) continue;
+                    parser.parseFacet(line, t);
+                    chunk.triangles.push_back(t);
+                    if (chunk.triangles.size() > max_triangles) break;
+                }
+            } catch (...) {
+                chunk.error = std::current_exception();
+            }
+            chunk.consumedEnd = lines.position();
+            chunk.nextLine = lines.lineNumber() + 1u;
+        };
+        parallelFor(chunkCount, numThreads, [&](std::size_t i) {
+            parseChunk(chunks[i], boundaries[i], boundaries[i + 1u], firstLines[i]);
+        });
+
+        // Stitch the chunks in order, replaying the serial semantics
+        std::size_t total{0};
+        for (std::size_t i = 0; i < chunkCount; ++i) {
+            // A facet of the previous chunk swallowed this chunk's first lines: re-parse from where it stopped
+            if (i > 0u && chunks[i - 1u].consumedEnd > boundaries[i]) {
+                const auto& previous = chunks[i - 1u];
+                if (previous.consumedEnd >= boundaries[i + 1u]) {
+                    chunks[i].triangles.clear();
+                    chunks[i].error = nullptr;
+                    chunks[i].consumedEnd = previous.consumedEnd;
+                    chunks[i].nextLine = previous.nextLine;
+                } else {
+                    parseChunk(chunks[i], previous.consumedEnd, boundaries[i + 1u], previous.nextLine);
+                }
+            }
+            total += chunks[i].triangles.size();
+            if (total > max_triangles) {
+                throw std::runtime_error("Triangle count exceeds the maximum allowable value.");
+            }
+            if (chunks[i].error) std::rethrow_exception(chunks[i].error);
+        }
+
+        OPENSTL_COUNT(TrianglesParsed, total);
+        std::vector<Triangle> tris(total);
+        OPENSTL_COUNT_ALLOCATION(total * sizeof(Triangle));
+        std::vector<std::size_t> offsets(chunkCount + 1u, 0u);
+        for (std::size_t i = 0; i < chunkCount; ++i) offsets[i + 1u] = offsets[i] + chunks[i].triangles.size();
+        parallelFor(chunkCount, numThreads, [&](std::size_t i) {
+            std::copy(chunks[i].triangles.begin(), chunks[i].triangles.end(), tris.begin() + offsets[i]);
+        });
+        return tris;
+    }
+
+    /**
+     * @brief Deserialize triangles from an ASCII STL input stream, on multiple threads.
+     *
+     * The remainder of the stream is loaded in memory and parsed with deserializeAsciiStlBufferParallel.
+     *
+     * @tparam Stream Input stream type.
+     * @param stream Stream containing ASCII STL data.
+     * @param max_triangles Optional safety bound (default: unlimited).
+     * @param numThreads Number of threads (0: one per hardware core).
+     *
+     * @return Vector of parsed triangles, identical to deserializeAsciiStl.
+     *
+     * @throws std::runtime_error On malformed geometry or size overflow.
+     */
+    template <typename Stream>
+    inline std::vector<Triangle> deserializeAsciiStlParallel(
+            Stream& stream,
+            std::size_t max_triangles = std::numeric_limits<std::size_t>::max(),
+            std::size_t numThreads = 0)
+    {
+        std::string buffer;
+        {
+            OPENSTL_TIMED_SCOPE("readAsciiStream");
+            constexpr std::size_t CHUNK_SIZE = 1u << 20;
+            for (;;) {
+                const std::size_t offset = buffer.size();
+                buffer.resize(offset + CHUNK_SIZE);
+                stream.read(&buffer[offset], static_cast<std::streamsize>(CHUNK_SIZE));
+                const auto received = static_cast<std::size_t>(stream.gcount());
+                buffer.resize(offset + received);
+                if (received < CHUNK_SIZE) break;
+            }
+            OPENSTL_COUNT(BytesRead, buffer.size());
+        }
+        return deserializeAsciiStlBufferParallel(buffer.data(), buffer.size(), max_triangles, numThreads);
+    }
+
+    /**
+     * @brief Read and validate the header of a binary STL stream.
+     *
+     * On return, the stream is positioned on the first triangle record and the stream is known to hold
+     * at least the announced number of triangles.
+     *
+     * @tparam Stream The type of the input stream.
+     * @param stream The input stream from which to read the binary STL header.
+     * @return The number of triangles announced by the header.
+     *
+     * @throws std::runtime_error If the header is incomplete or announces more triangles than available.
+     */
+    template <typename Stream>
+    uint32_t readBinaryStlHeader(Stream& stream) {
+        auto start_pos = stream.tellg();
+        stream.seekg(0, std::ios::end);
+        auto end_pos = stream.tellg();
+        stream.seekg(start_pos);
+
+        if (end_pos - start_pos < 84) {
+            throw std::runtime_error("File is too small to be a valid STL file.");
+        }
+
+        char header[80];
+        stream.read(header, sizeof(header));
+
+        if (stream.gcount() != sizeof(header)) {
+            throw std::runtime_error("Failed to read the full header. Possible corruption or incomplete file.");
+        }
+
+        uint32_t triangle_qty;
+        stream.read(reinterpret_cast<char*>(&triangle_qty), sizeof(triangle_qty));
+
+        if (stream.gcount() != sizeof(triangle_qty) || stream.fail() || stream.eof()) {
+            throw std::runtime_error("Failed to read the triangle count. Possible corruption or incomplete file.");
+        }
+
+        std::size_t expected_data_size = sizeof(Triangle) * triangle_qty;
+
+        if (end_pos - stream.tellg() < static_cast<std::streamoff>(expected_data_size)) {
             throw std::runtime_error("Not enough data in stream for the expected triangle count.");
         }
+        return triangle_qty;
+    }
 
+    /**
+     * @brief Deserialize a binary STL file from a stream and convert it to a vector of triangles.
+     *
+     * The header count is validated against the stream size and the read options before the triangles are
+     * allocated, in a single allocation of exactly the announced size.
+     *
+     * @tparam Stream The type of the input stream.
+     * @param stream The input stream from which to read the binary STL data.
+     * @param options The admission limits of the read.
+     * @return A vector of triangles representing the geometry from the binary STL file.
+     *
+     * @throws std::runtime_error If the data is corrupted or truncated, or exceeds the limits of the read.
+     */
+    template <typename Stream>
+    std::vector<Triangle> deserializeBinaryStl(Stream& stream, const ReadOptions& options = {}) {
+        OPENSTL_TIMED_SCOPE("deserializeBinaryStl");
+        const uint32_t triangle_qty = readBinaryStlHeader(stream);
+        detail::admitTriangles(triangle_qty, options);
+
+        std::size_t expected_data_size = sizeof(Triangle) * triangle_qty;
         std::vector<Triangle> triangles(triangle_qty);
-        stream.read(reinterpret_cast<char*>(triangles.data()), expected_data_size);
+        OPENSTL_COUNT_ALLOCATION(expected_data_size);
+        stream.read(reinterpret_cast<char*>(triangles.data()), static_cast<std::streamsize>(expected_data_size));
 
-        if (stream.gcount() != expected_data_size || stream.fail() || stream.eof()) {
+        if (static_cast<std::size_t>(stream.gcount()) != expected_data_size || stream.fail() || stream.eof()) {
             throw std::runtime_error("Failed to read the expected number of triangles. Possible corruption or incomplete file.");
         }
+        OPENSTL_COUNT(BytesRead, BINARY_STL_HEADER_SIZE + expected_data_size);
+        OPENSTL_COUNT(TrianglesParsed, triangle_qty);
 
         return triangles;
     }
@@ -369,38 +1534,1677 @@ namespace openstl
     }
 
     /**
-     * @brief Deserialize an STL file from a stream and convert it to a vector of triangles.
-     *
-     * This function detects the format of the STL file (ASCII or binary) by examining the content
-     * of the input stream and calls the appropriate deserialization function accordingly.
+     * @brief Deserialize an STL file from a stream and convert it to a vector of triangles.
+     *
+     * This function detects the format of the STL file (ASCII or binary) by examining the content
+     * of the input stream and calls the appropriate deserialization function accordingly.
+     *
+     * @tparam Stream The type of the input stream.
+     * @param stream The input stream from which to read the STL data.
+     * @param options The admission limits of the read.
+     * @return A vector of triangles representing the geometry from the STL file.
+     *
+     * @throws std::runtime_error If the data is malformed, or exceeds the limits of the read.
+     */
+    template <typename Stream>
+    inline std::vector<Triangle> deserializeStl(Stream& stream, const ReadOptions& options = {})
+    {
+        if (isAscii(stream)) {
+            return deserializeAsciiStl(stream, options.triangleLimit());
+        }
+        return deserializeBinaryStl(stream, options);
+    }
+
+    //---------------------------------------------------------------------------------------------------------
+    // Streaming Deserialize
+    //---------------------------------------------------------------------------------------------------------
+
+    /**
+     * @brief Pull-based STL reader delivering triangles in batches, in bounded memory.
+     *
+     * The format (ASCII or binary) is detected on construction, as in deserializeStl. Triangles are then read
+     * on demand into a fixed-size reusable buffer, so that arbitrarily large files can be reduced or filtered
+     * without holding the whole mesh in memory.
+     *
+     * @tparam Stream The type of the input stream.
+     */
+    template <typename Stream>
+    class StlBatchReader {
+    public:
+        static constexpr std::size_t DEFAULT_BATCH_SIZE = 1u << 16;
+
+        /**
+         * @param stream The input stream from which to read the STL data, positioned at its beginning.
+         * @param batchSize The maximum number of triangles per batch.
+         *
+         * @throws std::runtime_error If the binary header is invalid.
+         */
+        explicit StlBatchReader(Stream& stream, std::size_t batchSize = DEFAULT_BATCH_SIZE)
+                : stream_(stream), buffer_(std::max<std::size_t>(batchSize, 1u))
+        {
+            if (isAscii(stream_)) {
+                format_ = StlFormat::ASCII;
+                lines_ = std::make_unique<StreamLineReader<Stream>>(stream_);
+                parser_ = std::make_unique<AsciiStlParser<StreamLineReader<Stream>>>(*lines_);
+            } else {
+                format_ = StlFormat::Binary;
+                remaining_ = readBinaryStlHeader(stream_);
+            }
+        }
+
+        /** @brief The detected format of the stream. */
+        StlFormat format() const noexcept { return format_; }
+
+        /**
+         * @brief Read up to capacity triangles into a caller-provided buffer.
+         *
+         * @return The number of triangles read, 0 once the stream is exhausted.
+         *
+         * @throws std::runtime_error On malformed or truncated data.
+         */
+        std::size_t read(Triangle* out, std::size_t capacity) {
+            OPENSTL_TIMED_SCOPE("StlBatchReader::read");
+            std::size_t count{0};
+            if (format_ == StlFormat::ASCII) {
+                while (count < capacity && parser_->next(out[count])) ++count;
+            } else {
+                count = std::min<std::size_t>(capacity, remaining_);
+                const auto bytes = static_cast<std::streamsize>(count * sizeof(Triangle));
+                stream_.read(reinterpret_cast<char*>(out), bytes);
+                if (stream_.gcount() != bytes || stream_.fail()) {
+                    throw std::runtime_error("Failed to read the expected number of triangles. Possible corruption or incomplete file.");
+                }
+                remaining_ -= count;
+                OPENSTL_COUNT(BytesRead, bytes);
+            }
+            OPENSTL_COUNT(TrianglesParsed, count);
+            triangleCount_ += count;
+            return count;
+        }
+
+        /**
+         * @brief Read the next batch into the internal buffer, replacing the previous batch.
+         *
+         * @return False once the stream is exhausted.
+         */
+        bool next() {
+            batchCount_ = read(buffer_.data(), buffer_.size());
+            return batchCount_ != 0u;
+        }
+
+        /** @brief The triangles of the batch filled by the last call to next(). */
+        const Triangle* batchData() const noexcept { return buffer_.data(); }
+
+        /** @brief The number of triangles in the batch filled by the last call to next(). */
+        std::size_t batchCount() const noexcept { return batchCount_; }
+
+        /** @brief The number of triangles read so far. */
+        std::size_t triangleCount() const noexcept { return triangleCount_; }
+
+    private:
+        Stream& stream_;
+        StlFormat format_{StlFormat::Binary};
+        std::vector<Triangle> buffer_;
+        std::size_t batchCount_{0};
+        std::unique_ptr<StreamLineReader<Stream>> lines_;
+        std::unique_ptr<AsciiStlParser<StreamLineReader<Stream>>> parser_;
+        std::size_t remaining_{0};
+        std::size_t triangleCount_{0};
+    };
+
+    /**
+     * @brief Visit every triangle of an STL stream in batches, through a fixed-size reusable buffer.
+     *
+     * @tparam Stream The type of the input stream.
+     * @tparam Visitor Callable as visitor(const Triangle* triangles, std::size_t count).
+     * @param stream The input stream from which to read the STL data, positioned at its beginning.
+     * @param visitor The callable receiving each batch; the pointer is only valid during the call.
+     * @param batchSize The maximum number of triangles per batch.
+     * @return The total number of triangles visited.
+     *
+     * @throws std::runtime_error On malformed or truncated data.
+     */
+    template <typename Stream, typename Visitor>
+    inline std::size_t forEachTriangleBatch(Stream& stream, Visitor&& visitor,
+                                            std::size_t batchSize = StlBatchReader<Stream>::DEFAULT_BATCH_SIZE)
+    {
+        StlBatchReader<Stream> reader{stream, batchSize};
+        while (reader.next()) {
+            visitor(reader.batchData(), reader.batchCount());
+        }
+        return reader.triangleCount();
+    }
+
+    //---------------------------------------------------------------------------------------------------------
+    // Memory-mapped Deserialize
+    //---------------------------------------------------------------------------------------------------------
+
+    /**
+     * @brief A read-only memory mapping of a whole file.
+     *
+     * The mapping is released when the object is destroyed. Empty files are valid and yield a null data pointer.
+     */
+    class MappedFile {
+    public:
+        explicit MappedFile(const std::string& filename) {
+#ifdef _WIN32
+            file_ = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (file_ == INVALID_HANDLE_VALUE) {
+                throw std::runtime_error("Unable to open file '" + filename + "'.");
+            }
+            LARGE_INTEGER fileSize{};
+            if (!GetFileSizeEx(file_, &fileSize)) {
+                CloseHandle(file_);
+                throw std::runtime_error("Unable to query the size of file '" + filename + "'.");
+            }
+            size_ = static_cast<std::size_t>(fileSize.QuadPart);
+            if (size_ == 0) return;
+            mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping_ == nullptr) {
+                CloseHandle(file_);
+                throw std::runtime_error("Unable to map file '" + filename + "'.");
+            }
+            data_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+            if (data_ == nullptr) {
+                CloseHandle(mapping_);
+                CloseHandle(file_);
+                throw std::runtime_error("Unable to map file '" + filename + "'.");
+            }
+#else
+            const int fd = ::open(filename.c_str(), O_RDONLY);
+            if (fd < 0) {
+                throw std::runtime_error("Unable to open file '" + filename + "'.");
+            }
+            struct stat st{};
+            if (::fstat(fd, &st) != 0) {
+                ::close(fd);
+                throw std::runtime_error("Unable to query the size of file '" + filename + "'.");
+            }
+            size_ = static_cast<std::size_t>(st.st_size);
+            if (size_ == 0) {
+                ::close(fd);
+                return;
+            }
+            void* addr = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+            ::close(fd); // The mapping keeps its own reference to the file
+            if (addr == MAP_FAILED) {
+                throw std::runtime_error("Unable to map file '" + filename + "'.");
+            }
+            data_ = static_cast<const char*>(addr);
+#endif
+        }
+
+        ~MappedFile() { release(); }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        MappedFile(MappedFile&& other) noexcept { swap(other); }
+        MappedFile& operator=(MappedFile&& other) noexcept {
+            if (this != &other) {
+                release();
+                swap(other);
+            }
+            return *this;
+        }
+
+        const char* data() const noexcept { return data_; }
+        std::size_t size() const noexcept { return size_; }
+
+    private:
+        void swap(MappedFile& other) noexcept {
+            std::swap(data_, other.data_);
+            std::swap(size_, other.size_);
+#ifdef _WIN32
+            std::swap(file_, other.file_);
+            std::swap(mapping_, other.mapping_);
+#endif
+        }
+
+        void release() noexcept {
+#ifdef _WIN32
+            if (data_ != nullptr) UnmapViewOfFile(data_);
+            if (mapping_ != nullptr) CloseHandle(mapping_);
+            if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+            mapping_ = nullptr;
+            file_ = INVALID_HANDLE_VALUE;
+#else
+            if (data_ != nullptr) ::munmap(const_cast<char*>(data_), size_);
+#endif
+            data_ = nullptr;
+            size_ = 0;
+        }
+
+        const char* data_{nullptr};
+        std::size_t size_{0};
+#ifdef _WIN32
+        HANDLE file_{INVALID_HANDLE_VALUE};
+        HANDLE mapping_{nullptr};
+#endif
+    };
+
+    /**
+     * @brief A read-only view over the packed triangle records of a memory-mapped binary STL file.
+     *
+     * The view shares ownership of the mapping, so copies of it keep the file mapped. The triangle count read
+     * from the header is validated against the file size on construction, hence iterating the view never
+     * reads outside of the mapping. It is a drop-in container for serialize and convertToVerticesAndFaces.
+     */
+    class MappedTriangles {
+    public:
+        using value_type = Triangle;
+        using const_iterator = const Triangle*;
+
+        explicit MappedTriangles(std::shared_ptr<const MappedFile> file) : file_(std::move(file)) {
+            if (!file_ || file_->size() < 84) {
+                throw std::runtime_error("File is too small to be a valid STL file.");
+            }
+            uint32_t triangle_qty;
+            std::memcpy(&triangle_qty, file_->data() + 80, sizeof(triangle_qty));
+            if ((file_->size() - 84) / sizeof(Triangle) < triangle_qty) {
+                throw std::runtime_error("Not enough data in stream for the expected triangle count.");
+            }
+            data_ = reinterpret_cast<const Triangle*>(file_->data() + 84);
+            size_ = triangle_qty;
+        }
+
+        const_iterator begin() const noexcept { return data_; }
+        const_iterator end() const noexcept { return data_ + size_; }
+        const Triangle* data() const noexcept { return data_; }
+        std::size_t size() const noexcept { return size_; }
+        bool empty() const noexcept { return size_ == 0; }
+
+        const Triangle& operator[](std::size_t index) const noexcept { return data_[index]; }
+
+        const Triangle& at(std::size_t index) const {
+            if (index >= size_) {
+                throw std::out_of_range("Triangle index out of range");
+            }
+            return data_[index];
+        }
+
+        /**
+         * @brief The header comment of the binary STL file (80 bytes, not null-terminated).
+         */
+        std::string_view header() const noexcept { return {file_->data(), 80}; }
+
+    private:
+        std::shared_ptr<const MappedFile> file_;
+        const Triangle* data_{nullptr};
+        std::size_t size_{0};
+    };
+
+    /**
+     * @brief Memory-map a binary STL file and expose its triangles without copying them.
+     *
+     * @param filename The path of the binary STL file.
+     * @param options The admission limits of the read, the budget bounding the mapped triangle data.
+     * @return A read-only view over the triangles, valid for as long as the view (or a copy of it) exists.
+     *
+     * @throws std::runtime_error If the file cannot be mapped, if its header count exceeds the file size or
+     * the limits of the read.
+     */
+    inline MappedTriangles mapBinaryStl(const std::string& filename, const ReadOptions& options = {}) {
+        OPENSTL_TIMED_SCOPE("mapBinaryStl");
+        MappedTriangles triangles{std::make_shared<const MappedFile>(filename)};
+        detail::admitTriangles(triangles.size(), options);
+        return triangles;
+    }
+
+    //---------------------------------------------------------------------------------------------------------
+    // Normal Utils
+    //---------------------------------------------------------------------------------------------------------
+    /** @brief Default angle (radians) beyond which a stored normal disagrees with the winding of its triangle. */
+    constexpr float DEFAULT_NORMAL_ANGLE_TOLERANCE = 1e-2f;
+
+    namespace detail {
+        /**
+         * @brief Compute the unit normal of one triangle record: (v1 - v0) x (v2 - v0) normalized, or zero for
+         * degenerate (or non-finite) triangles.
+         *
+         * The vectorized kernels perform the same operations in the same order, hence give identical results,
+         * unless the compiler contracts them into FMAs.
+         */
+        inline void computeUnitNormal(const unsigned char* record, float normal[3]) noexcept {
+            float v[9];
+            std::memcpy(v, record + 3u * sizeof(float), sizeof(v));
+            const float ax = v[3] - v[0], ay = v[4] - v[1], az = v[5] - v[2];
+            const float bx = v[6] - v[0], by = v[7] - v[1], bz = v[8] - v[2];
+            const float cx = ay * bz - az * by, cy = az * bx - ax * bz, cz = ax * by - ay * bx;
+            const float length = std::sqrt((cx * cx + cy * cy) + cz * cz);
+            const bool valid = length > 0.f;
+            normal[0] = valid ? cx / length : 0.f;
+            normal[1] = valid ? cy / length : 0.f;
+            normal[2] = valid ? cz / length : 0.f;
+        }
+
+        /** @brief Whether a stored normal disagrees with the computed unit normal, see findInconsistentNormals. */
+        inline bool isInconsistentNormal(const unsigned char* record, const float normal[3], float minCosine) noexcept {
+            if (normal[0] == 0.f && normal[1] == 0.f && normal[2] == 0.f) return false; // Degenerate
+            float stored[3];
+            std::memcpy(stored, record, sizeof(stored));
+            const float length = std::sqrt((stored[0] * stored[0] + stored[1] * stored[1]) + stored[2] * stored[2]);
+            const float dot = (stored[0] * normal[0] + stored[1] * normal[1]) + stored[2] * normal[2];
+            return !(length > 0.f && dot >= minCosine * length);
+        }
+
+#if defined(OPENSTL_SIMD_AVX2) || defined(OPENSTL_SIMD_SSE2)
+        /**
+         * @brief Load 4 triangle records, stride bytes apart, as 12 vectors of components: normal x, y, z, then
+         * v0, v1 and v2. Each record is read with 3 unaligned loads, then transposed.
+         */
+        inline void loadRecords4(const unsigned char* first, std::size_t stride, __m128 (&c)[12]) noexcept {
+            for (int part = 0; part < 3; ++part) {
+                __m128 r0 = _mm_loadu_ps(reinterpret_cast<const float*>(first + 4 * part * sizeof(float)));
+                __m128 r1 = _mm_loadu_ps(reinterpret_cast<const float*>(first + stride + 4 * part * sizeof(float)));
+                __m128 r2 = _mm_loadu_ps(reinterpret_cast<const float*>(first + 2 * stride + 4 * part * sizeof(float)));
+                __m128 r3 = _mm_loadu_ps(reinterpret_cast<const float*>(first + 3 * stride + 4 * part * sizeof(float)));
+                _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+                c[4 * part] = r0; c[4 * part + 1] = r1; c[4 * part + 2] = r2; c[4 * part + 3] = r3;
+            }
+        }
+
+        /** @brief Store 4 normals back to their records; the 4th lane rewrites v0.x with its own value. */
+        inline void storeNormals4(unsigned char* first, std::size_t stride, __m128 nx, __m128 ny, __m128 nz,
+                                  __m128 v0x) noexcept {
+            _MM_TRANSPOSE4_PS(nx, ny, nz, v0x);
+            _mm_storeu_ps(reinterpret_cast<float*>(first), nx);
+            _mm_storeu_ps(reinterpret_cast<float*>(first + stride), ny);
+            _mm_storeu_ps(reinterpret_cast<float*>(first + 2 * stride), nz);
+            _mm_storeu_ps(reinterpret_cast<float*>(first + 3 * stride), v0x);
+        }
+
+        /** @brief Store 12 vectors of components back to 4 records, the inverse of loadRecords4. */
+        inline void storeRecords4(unsigned char* first, std::size_t stride, const __m128 (&c)[12]) noexcept {
+            for (int part = 0; part < 3; ++part) {
+                __m128 r0 = c[4 * part], r1 = c[4 * part + 1], r2 = c[4 * part + 2], r3 = c[4 * part + 3];
+                _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+                _mm_storeu_ps(reinterpret_cast<float*>(first + 4 * part * sizeof(float)), r0);
+                _mm_storeu_ps(reinterpret_cast<float*>(first + stride + 4 * part * sizeof(float)), r1);
+                _mm_storeu_ps(reinterpret_cast<float*>(first + 2 * stride + 4 * part * sizeof(float)), r2);
+                _mm_storeu_ps(reinterpret_cast<float*>(first + 3 * stride + 4 * part * sizeof(float)), r3);
+            }
+        }
+
+        inline void computeUnitNormals4(const __m128 (&c)[12], __m128 (&n)[3]) noexcept {
+            const __m128 ax = _mm_sub_ps(c[6], c[3]), ay = _mm_sub_ps(c[7], c[4]), az = _mm_sub_ps(c[8], c[5]);
+            const __m128 bx = _mm_sub_ps(c[9], c[3]), by = _mm_sub_ps(c[10], c[4]), bz = _mm_sub_ps(c[11], c[5]);
+            const __m128 cx = _mm_sub_ps(_mm_mul_ps(ay, bz), _mm_mul_ps(az, by));
+            const __m128 cy = _mm_sub_ps(_mm_mul_ps(az, bx), _mm_mul_ps(ax, bz));
+            const __m128 cz = _mm_sub_ps(_mm_mul_ps(ax, by), _mm_mul_ps(ay, bx));
+            const __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, cx), _mm_mul_ps(cy, cy)),
+                                                         _mm_mul_ps(cz, cz)));
+            const __m128 valid = _mm_cmpgt_ps(length, _mm_setzero_ps());
+            n[0] = _mm_and_ps(valid, _mm_div_ps(cx, length));
+            n[1] = _mm_and_ps(valid, _mm_div_ps(cy, length));
+            n[2] = _mm_and_ps(valid, _mm_div_ps(cz, length));
+        }
+#endif
+
+#if defined(OPENSTL_SIMD_AVX2)
+        /** @brief computeUnitNormals4 over 8 records at once, given as two groups of 4. */
+        inline void computeUnitNormals8(const __m128 (&lo)[12], const __m128 (&hi)[12], __m128 (&nlo)[3],
+                                        __m128 (&nhi)[3]) noexcept {
+            __m256 c[12];
+            for (int k = 0; k < 12; ++k) c[k] = _mm256_insertf128_ps(_mm256_castps128_ps256(lo[k]), hi[k], 1);
+            const __m256 ax = _mm256_sub_ps(c[6], c[3]), ay = _mm256_sub_ps(c[7], c[4]), az = _mm256_sub_ps(c[8], c[5]);
+            const __m256 bx = _mm256_sub_ps(c[9], c[3]), by = _mm256_sub_ps(c[10], c[4]), bz = _mm256_sub_ps(c[11], c[5]);
+            const __m256 cx = _mm256_sub_ps(_mm256_mul_ps(ay, bz), _mm256_mul_ps(az, by));
+            const __m256 cy = _mm256_sub_ps(_mm256_mul_ps(az, bx), _mm256_mul_ps(ax, bz));
+            const __m256 cz = _mm256_sub_ps(_mm256_mul_ps(ax, by), _mm256_mul_ps(ay, bx));
+            const __m256 length = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(
+                    _mm256_mul_ps(cx, cx), _mm256_mul_ps(cy, cy)), _mm256_mul_ps(cz, cz)));
+            const __m256 valid = _mm256_cmp_ps(length, _mm256_setzero_ps(), _CMP_GT_OQ);
+            const __m256 n[3] = {_mm256_and_ps(valid, _mm256_div_ps(cx, length)),
+                                 _mm256_and_ps(valid, _mm256_div_ps(cy, length)),
+                                 _mm256_and_ps(valid, _mm256_div_ps(cz, length))};
+            for (int k = 0; k < 3; ++k) {
+                nlo[k] = _mm256_castps256_ps128(n[k]);
+                nhi[k] = _mm256_extractf128_ps(n[k], 1);
+            }
+        }
+#endif
+    } //namespace detail
+
+    /**
+     * @brief Recompute the unit normals of triangle records in place, from their winding.
+     *
+     * Records hold the normal then v0, v1 and v2 as 12 consecutive floats, and are stride bytes apart: 50 for
+     * packed Triangle storage, 48 for a (N,4,3) float array. The normal becomes (v1 - v0) x (v2 - v0)
+     * normalized, or zero for degenerate triangles. Records are transposed in registers and processed 8 at a
+     * time with AVX2, 4 at a time with SSE2, or one by one otherwise, depending on the compiler target.
+     *
+     * @param records The first record, not necessarily aligned.
+     * @param count The number of records.
+     * @param stride The distance between two records, in bytes, at least 48.
+     */
+    inline void computeNormals(void* records, std::size_t count, std::size_t stride) noexcept {
+        OPENSTL_TIMED_SCOPE("computeNormals");
+        auto* bytes = static_cast<unsigned char*>(records);
+        std::size_t i{0};
+#if defined(OPENSTL_SIMD_AVX2)
+        for (; i + 8u <= count; i += 8u) {
+            __m128 lo[12], hi[12], nlo[3], nhi[3];
+            detail::loadRecords4(bytes + i * stride, stride, lo);
+            detail::loadRecords4(bytes + (i + 4u) * stride, stride, hi);
+            detail::computeUnitNormals8(lo, hi, nlo, nhi);
+            detail::storeNormals4(bytes + i * stride, stride, nlo[0], nlo[1], nlo[2], lo[3]);
+            detail::storeNormals4(bytes + (i + 4u) * stride, stride, nhi[0], nhi[1], nhi[2], hi[3]);
+        }
+#endif
+#if defined(OPENSTL_SIMD_AVX2) || defined(OPENSTL_SIMD_SSE2)
+        for (; i + 4u <= count; i += 4u) {
+            __m128 c[12], n[3];
+            detail::loadRecords4(bytes + i * stride, stride, c);
+            detail::computeUnitNormals4(c, n);
+            detail::storeNormals4(bytes + i * stride, stride, n[0], n[1], n[2], c[3]);
+        }
+#endif
+        for (; i < count; ++i) {
+            float normal[3];
+            detail::computeUnitNormal(bytes + i * stride, normal);
+            std::memcpy(bytes + i * stride, normal, sizeof(normal));
+        }
+    }
+
+    /**
+     * @brief Recompute the unit normals of contiguous triangles in place, see computeNormals(void*, size_t, size_t).
+     */
+    template<typename Container>
+    inline void computeNormals(Container& triangles) noexcept {
+        static_assert(detail::HasMutableContiguousTriangles<Container>::value,
+                      "The triangles must be stored contiguously and be writable");
+        computeNormals(triangles.data(), static_cast<std::size_t>(triangles.size()), sizeof(Triangle));
+    }
+
+    /**
+     * @brief Find the triangle records whose stored normal disagrees with their winding.
+     *
+     * A stored normal disagrees when its angle with the unit normal computed from the winding exceeds the
+     * tolerance, or when it is zero or not finite. Degenerate triangles have no meaningful normal and are
+     * never reported.
+     *
+     * @param records The first record, laid out as for computeNormals.
+     * @param count The number of records.
+     * @param stride The distance between two records, in bytes, at least 48.
+     * @param angleTolerance The largest accepted angle, in radians.
+     * @return The indices of the inconsistent records, in increasing order.
+     */
+    inline std::vector<std::size_t> findInconsistentNormals(const void* records, std::size_t count,
+                                                            std::size_t stride,
+                                                            float angleTolerance = DEFAULT_NORMAL_ANGLE_TOLERANCE) {
+        OPENSTL_TIMED_SCOPE("findInconsistentNormals");
+        const auto* bytes = static_cast<const unsigned char*>(records);
+        const float minCosine = std::cos(std::min(std::max(angleTolerance, 0.f), 3.14159265f));
+        std::vector<std::size_t> inconsistent;
+        std::size_t i{0};
+#if defined(OPENSTL_SIMD_AVX2) || defined(OPENSTL_SIMD_SSE2)
+        const __m128 zero = _mm_setzero_ps(), cosine = _mm_set1_ps(minCosine);
+        for (; i + 4u <= count; i += 4u) {
+            __m128 c[12], n[3];
+            detail::loadRecords4(bytes + i * stride, stride, c);
+            detail::computeUnitNormals4(c, n);
+            const __m128 degenerate = _mm_and_ps(_mm_and_ps(_mm_cmpeq_ps(n[0], zero), _mm_cmpeq_ps(n[1], zero)),
+                                                 _mm_cmpeq_ps(n[2], zero));
+            const __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(c[0], c[0]), _mm_mul_ps(c[1], c[1])),
+                                                         _mm_mul_ps(c[2], c[2])));
+            const __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c[0], n[0]), _mm_mul_ps(c[1], n[1])),
+                                          _mm_mul_ps(c[2], n[2]));
+            const __m128 consistent = _mm_and_ps(_mm_cmpgt_ps(length, zero),
+                                                 _mm_cmpge_ps(dot, _mm_mul_ps(cosine, length)));
+            const int mask = _mm_movemask_ps(_mm_andnot_ps(_mm_or_ps(degenerate, consistent), _mm_castsi128_ps(
+                    _mm_set1_epi32(-1))));
+            for (int lane = 0; lane < 4; ++lane) {
+                if (mask & (1 << lane)) inconsistent.push_back(i + static_cast<std::size_t>(lane));
+            }
+        }
+#endif
+        for (; i < count; ++i) {
+            float normal[3];
+            detail::computeUnitNormal(bytes + i * stride, normal);
+            if (detail::isInconsistentNormal(bytes + i * stride, normal, minCosine)) inconsistent.push_back(i);
+        }
+        return inconsistent;
+    }
+
+    /**
+     * @brief Find the triangles whose stored normal disagrees with their winding, see
+     * findInconsistentNormals(const void*, size_t, size_t, float).
+     */
+    template<typename Container>
+    inline std::vector<std::size_t> findInconsistentNormals(const Container& triangles,
+                                                            float angleTolerance = DEFAULT_NORMAL_ANGLE_TOLERANCE) {
+        static_assert(detail::HasContiguousTriangles<Container>::value, "The triangles must be stored contiguously");
+        return findInconsistentNormals(triangles.data(), static_cast<std::size_t>(triangles.size()),
+                                       sizeof(Triangle), angleTolerance);
+    }
+
+    //---------------------------------------------------------------------------------------------------------
+    // Structure-of-Arrays Utils
+    //---------------------------------------------------------------------------------------------------------
+    namespace detail {
+        /**
+         * @brief An allocator of cache-line aligned storage, so that vectorized loops start on aligned data.
+         * Elements are default-initialized, which lets arrays about to be overwritten skip zero-filling.
+         */
+        template<typename T, std::size_t Alignment = 64>
+        struct AlignedAllocator {
+            using value_type = T;
+            template<typename U>
+            struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+            AlignedAllocator() noexcept = default;
+            template<typename U>
+            AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+            T* allocate(std::size_t n) {
+                return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{Alignment}));
+            }
+            void deallocate(T* ptr, std::size_t) noexcept {
+                ::operator delete(ptr, std::align_val_t{Alignment});
+            }
+            template<typename U, typename... Args>
+            void construct(U* ptr, Args&&... args) {
+                if constexpr (sizeof...(Args) == 0) ::new(static_cast<void*>(ptr)) U;
+                else ::new(static_cast<void*>(ptr)) U(std::forward<Args>(args)...);
+            }
+
+            template<typename U>
+            bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+            template<typename U>
+            bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+        };
+    } //namespace detail
+
+    using AlignedFloats = std::vector<float, detail::AlignedAllocator<float>>;
+
+    /**
+     * @brief Triangles stored as a structure of arrays: one aligned array per component.
+     *
+     * The 12 components follow the order of a triangle record: normal x, y, z, then v0, v1 and v2. Per-triangle
+     * math over these arrays compiles to plain vector loads, unlike the packed 50-byte Triangle records.
+     * TriangleArrays can be indexed and iterated like a container of Triangle, returned by value, so that the
+     * generic algorithms (serialization, welding) accept it as well.
+     */
+    class TriangleArrays {
+    public:
+        static constexpr std::size_t COMPONENTS = 12;
+
+        class const_iterator {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = Triangle;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = Triangle;
+
+            const_iterator(const TriangleArrays* arrays, std::size_t index) noexcept
+                : arrays_{arrays}, index_{index} {}
+            Triangle operator*() const noexcept { return (*arrays_)[index_]; }
+            const_iterator& operator++() noexcept { ++index_; return *this; }
+            const_iterator operator++(int) noexcept { auto copy = *this; ++index_; return copy; }
+            bool operator==(const const_iterator& other) const noexcept { return index_ == other.index_; }
+            bool operator!=(const const_iterator& other) const noexcept { return index_ != other.index_; }
+
+        private:
+            const TriangleArrays* arrays_;
+            std::size_t index_;
+        };
+
+        TriangleArrays() = default;
+        explicit TriangleArrays(std::size_t count) { resize(count); }
+
+        std::size_t size() const noexcept { return components_[0].size(); }
+        bool empty() const noexcept { return components_[0].empty(); }
+
+        /** @brief Resize every component array, new triangles being zero. */
+        void resize(std::size_t count) {
+            for (auto& component : components_) component.resize(count, 0.f);
+        }
+
+        /** @brief The array of a component, in record order (0-2: normal, 3-5: v0, 6-8: v1, 9-11: v2). */
+        float* component(std::size_t index) noexcept { return components_[index].data(); }
+        const float* component(std::size_t index) const noexcept { return components_[index].data(); }
+
+        /** @brief The array of an axis (0: x, 1: y, 2: z) of the normals. */
+        float* normal(std::size_t axis) noexcept { return component(axis); }
+        const float* normal(std::size_t axis) const noexcept { return component(axis); }
+
+        /** @brief The array of an axis (0: x, 1: y, 2: z) of a corner (0: v0, 1: v1, 2: v2) of the triangles. */
+        float* vertex(std::size_t corner, std::size_t axis) noexcept { return component(3u + 3u * corner + axis); }
+        const float* vertex(std::size_t corner, std::size_t axis) const noexcept {
+            return component(3u + 3u * corner + axis);
+        }
+
+        Triangle operator[](std::size_t index) const noexcept {
+            float values[COMPONENTS];
+            for (std::size_t k = 0; k < COMPONENTS; ++k) values[k] = components_[k][index];
+            Triangle tri{};
+            std::memcpy(&tri, values, sizeof(values));
+            return tri;
+        }
+
+        void set(std::size_t index, const Triangle& tri) noexcept {
+            float values[COMPONENTS];
+            std::memcpy(values, &tri, sizeof(values));
+            for (std::size_t k = 0; k < COMPONENTS; ++k) components_[k][index] = values[k];
+        }
+
+        const_iterator begin() const noexcept { return {this, 0u}; }
+        const_iterator end() const noexcept { return {this, size()}; }
+
+        /**
+         * @brief Transpose triangle records into arrays, replacing the content and reusing the capacity.
+         *
+         * Records hold 12 consecutive floats, stride bytes apart: 50 for packed Triangle storage, 48 for a
+         * (N,4,3) float array. Groups of 4 records are transposed in registers when SSE2 is available.
+         * @param records The first record, not necessarily aligned.
+         * @param count The number of records.
+         * @param stride The distance between two records, in bytes, at least 48.
+         *
+         * @throws std::length_error If count records of stride bytes exceed the address space.
+         */
+        void assignRecords(const void* records, std::size_t count, std::size_t stride) {
+            if (stride != 0u && count > std::numeric_limits<std::size_t>::max() / stride) {
+                throw std::length_error("TriangleArrays: too many records");
+            }
+            for (auto& component : components_) component.resize(count); // New elements left uninitialized
+            const auto* record = static_cast<const unsigned char*>(records);
+#if defined(OPENSTL_SIMD_AVX2) || defined(OPENSTL_SIMD_SSE2)
+            const std::size_t blocked = count - count % 4u;
+            for (std::size_t i = 0; i < blocked; i += 4u, record += 4u * stride) {
+                __m128 c[COMPONENTS];
+                detail::loadRecords4(record, stride, c);
+                for (std::size_t k = 0; k < COMPONENTS; ++k) _mm_storeu_ps(component(k) + i, c[k]);
+            }
+#else
+            const std::size_t blocked = 0;
+#endif
+            for (std::size_t i = blocked; i < count; ++i, record += stride) {
+                float values[COMPONENTS];
+                std::memcpy(values, record, sizeof(values));
+                for (std::size_t k = 0; k < COMPONENTS; ++k) component(k)[i] = values[k];
+            }
+        }
+
+        /** @brief Transpose triangle records into new arrays, see assignRecords. */
+        static TriangleArrays fromRecords(const void* records, std::size_t count, std::size_t stride) {
+            TriangleArrays arrays;
+            arrays.assignRecords(records, count, stride);
+            return arrays;
+        }
+
+        /**
+         * @brief Transpose the arrays back into size() triangle records, laid out as for fromRecords.
+         *
+         * Only the 12 floats of each record are written; the bytes in between, such as the attribute byte
+         * count of a Triangle, are left untouched.
+         */
+        void toRecords(void* records, std::size_t stride) const noexcept {
+            auto* bytes = static_cast<unsigned char*>(records);
+            const std::size_t count = size();
+            std::size_t i{0};
+#if defined(OPENSTL_SIMD_AVX2) || defined(OPENSTL_SIMD_SSE2)
+            for (; i + 4u <= count; i += 4u) {
+                __m128 c[COMPONENTS];
+                for (std::size_t k = 0; k < COMPONENTS; ++k) c[k] = _mm_loadu_ps(component(k) + i);
+                detail::storeRecords4(bytes + i * stride, stride, c);
+            }
+#endif
+            for (; i < count; ++i) {
+                float values[COMPONENTS];
+                for (std::size_t k = 0; k < COMPONENTS; ++k) values[k] = component(k)[i];
+                std::memcpy(bytes + i * stride, values, sizeof(values));
+            }
+        }
+
+    private:
+        std::array<AlignedFloats, COMPONENTS> components_;
+    };
+
+    /**
+     * @brief Convert triangles to TriangleArrays, transposing contiguous containers in blocks.
+     */
+    template<typename Container>
+    inline TriangleArrays toTriangleArrays(const Container& triangles) {
+        if constexpr (detail::HasContiguousTriangles<Container>::value) {
+            return TriangleArrays::fromRecords(triangles.data(), static_cast<std::size_t>(triangles.size()),
+                                               sizeof(Triangle));
+        } else {
+            TriangleArrays arrays{static_cast<std::size_t>(triangles.size())};
+            std::size_t index{0};
+            for (const auto& tri : triangles) arrays.set(index++, tri);
+            return arrays;
+        }
+    }
+
+    /**
+     * @brief Convert TriangleArrays back to a vector of triangles, with a zero attribute byte count.
+     */
+    inline std::vector<Triangle> toTriangles(const TriangleArrays& arrays) {
+        std::vector<Triangle> triangles(arrays.size());
+        arrays.toRecords(triangles.data(), sizeof(Triangle));
+        return triangles;
+    }
+
+    /**
+     * @brief Recompute the unit normals of TriangleArrays in place, with the same results as
+     * computeNormals(void*, size_t, size_t).
+     *
+     * The loop autovectorizes once sqrt needs not set errno (-fno-math-errno, as in the Release flags).
+     */
+    inline void computeNormals(TriangleArrays& arrays) noexcept {
+        const std::size_t count = arrays.size();
+        const float* v0x = arrays.vertex(0, 0); const float* v0y = arrays.vertex(0, 1); const float* v0z = arrays.vertex(0, 2);
+        const float* v1x = arrays.vertex(1, 0); const float* v1y = arrays.vertex(1, 1); const float* v1z = arrays.vertex(1, 2);
+        const float* v2x = arrays.vertex(2, 0); const float* v2y = arrays.vertex(2, 1); const float* v2z = arrays.vertex(2, 2);
+        float* nx = arrays.normal(0); float* ny = arrays.normal(1); float* nz = arrays.normal(2);
+        for (std::size_t i = 0; i < count; ++i) {
+            const float ax = v1x[i] - v0x[i], ay = v1y[i] - v0y[i], az = v1z[i] - v0z[i];
+            const float bx = v2x[i] - v0x[i], by = v2y[i] - v0y[i], bz = v2z[i] - v0z[i];
+            const float cx = ay * bz - az * by, cy = az * bx - ax * bz, cz = ax * by - ay * bx;
+            const float length = std::sqrt((cx * cx + cy * cy) + cz * cz);
+            const float ux = cx / length, uy = cy / length, uz = cz / length;
+            const bool valid = length > 0.f;
+            nx[i] = valid ? ux : 0.f;
+            ny[i] = valid ? uy : 0.f;
+            nz[i] = valid ? uz : 0.f;
+        }
+    }
+
+    /**
+     * @brief An axis-aligned bounding box. Empty boxes have lower > upper.
+     */
+    struct BoundingBox {
+        Vec3 lower{std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(),
+                   std::numeric_limits<float>::infinity()};
+        Vec3 upper{-std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+                   -std::numeric_limits<float>::infinity()};
+
+        bool empty() const noexcept { return !(lower.x <= upper.x && lower.y <= upper.y && lower.z <= upper.z); }
+    };
+
+    namespace detail {
+        /** @brief Extend [lower, upper] by the values of an array, ignoring NaN, over 16 independent lanes. */
+        inline void extendRange(const float* values, std::size_t count, float& lower, float& upper) noexcept {
+            constexpr std::size_t LANES = 16;
+            float lo[LANES], hi[LANES];
+            for (std::size_t k = 0; k < LANES; ++k) { lo[k] = lower; hi[k] = upper; }
+            std::size_t i{0};
+            for (; i + LANES <= count; i += LANES) {
+                for (std::size_t k = 0; k < LANES; ++k) {
+                    const float v = values[i + k];
+                    lo[k] = v < lo[k] ? v : lo[k];
+                    hi[k] = v > hi[k] ? v : hi[k];
+                }
+            }
+            for (; i < count; ++i) {
+                lo[0] = values[i] < lo[0] ? values[i] : lo[0];
+                hi[0] = values[i] > hi[0] ? values[i] : hi[0];
+            }
+            for (std::size_t k = 0; k < LANES; ++k) {
+                lower = lo[k] < lower ? lo[k] : lower;
+                upper = hi[k] > upper ? hi[k] : upper;
+            }
+        }
+
+        inline void extendBox(BoundingBox& box, const Vec3& v) noexcept {
+            box.lower = {v.x < box.lower.x ? v.x : box.lower.x, v.y < box.lower.y ? v.y : box.lower.y,
+                         v.z < box.lower.z ? v.z : box.lower.z};
+            box.upper = {v.x > box.upper.x ? v.x : box.upper.x, v.y > box.upper.y ? v.y : box.upper.y,
+                         v.z > box.upper.z ? v.z : box.upper.z};
+        }
+    } //namespace detail
+
+    /**
+     * @brief Compute the bounding box of the vertices of triangles, ignoring NaN coordinates.
+     */
+    template<typename Container>
+    inline BoundingBox computeBoundingBox(const Container& triangles) noexcept {
+        BoundingBox box{};
+        for (const auto& tri : triangles) {
+            detail::extendBox(box, tri.v0);
+            detail::extendBox(box, tri.v1);
+            detail::extendBox(box, tri.v2);
+        }
+        return box;
+    }
+
+    /**
+     * @brief Compute the bounding box of TriangleArrays, one vectorized pass per component array.
+     */
+    inline BoundingBox computeBoundingBox(const TriangleArrays& arrays) noexcept {
+        BoundingBox box{};
+        for (std::size_t corner = 0; corner < 3u; ++corner) {
+            detail::extendRange(arrays.vertex(corner, 0), arrays.size(), box.lower.x, box.upper.x);
+            detail::extendRange(arrays.vertex(corner, 1), arrays.size(), box.lower.y, box.upper.y);
+            detail::extendRange(arrays.vertex(corner, 2), arrays.size(), box.lower.z, box.upper.z);
+        }
+        return box;
+    }
+
+    namespace detail {
+        /** @brief A corner (0: v0, 1: v1, 2: v2) of a triangle of a container, as used by the welding. */
+        template<typename Container>
+        inline Vec3 vertexAt(const Container& triangles, std::size_t index, std::size_t corner) noexcept {
+            const auto& tri = triangles[index];
+            return corner == 0u ? tri.v0 : (corner == 1u ? tri.v1 : tri.v2);
+        }
+
+        inline Vec3 vertexAt(const TriangleArrays& arrays, std::size_t index, std::size_t corner) noexcept {
+            return {arrays.vertex(corner, 0)[index], arrays.vertex(corner, 1)[index], arrays.vertex(corner, 2)[index]};
+        }
+    } //namespace detail
+
+    //---------------------------------------------------------------------------------------------------------
+    // Transform Utils
+    //---------------------------------------------------------------------------------------------------------
+    /**
+     * @brief A 3x4 affine transform in row-major order: the linear part in columns 0-2, the translation in
+     * column 3, so that p' = A p + t.
+     */
+    using AffineMatrix = std::array<float, 12>;
+
+    namespace detail {
+        constexpr std::size_t TRANSFORM_CHUNK_SIZE = std::size_t{1} << 14u;
+
+        /**
+         * @brief The 3x3 matrix transforming normals: the inverse-transpose of the linear part, up to a positive
+         * factor. It is computed as the cofactor matrix times the sign of the determinant, which stays defined
+         * for singular matrices.
+         */
+        inline std::array<float, 9> normalMatrix(const AffineMatrix& m) noexcept {
+            const double a[9] = {m[0], m[1], m[2], m[4], m[5], m[6], m[8], m[9], m[10]};
+            double cofactors[9] = {a[4] * a[8] - a[5] * a[7], a[5] * a[6] - a[3] * a[8], a[3] * a[7] - a[4] * a[6],
+                                   a[2] * a[7] - a[1] * a[8], a[0] * a[8] - a[2] * a[6], a[1] * a[6] - a[0] * a[7],
+                                   a[1] * a[5] - a[2] * a[4], a[2] * a[3] - a[0] * a[5], a[0] * a[4] - a[1] * a[3]};
+            const double determinant = a[0] * cofactors[0] + a[1] * cofactors[1] + a[2] * cofactors[2];
+            double largest{0.0};
+            for (const double c : cofactors) largest = std::max(largest, std::abs(c));
+            const double scale = (determinant < 0.0 ? -1.0 : 1.0) / (largest > 0.0 ? largest : 1.0);
+            std::array<float, 9> n{};
+            for (std::size_t k = 0; k < 9u; ++k) n[k] = static_cast<float>(cofactors[k] * scale);
+            return n;
+        }
+
+        inline void transformPoint(const AffineMatrix& m, const float p[3], float out[3]) noexcept {
+            const float x = ((m[0] * p[0] + m[1] * p[1]) + m[2] * p[2]) + m[3];
+            const float y = ((m[4] * p[0] + m[5] * p[1]) + m[6] * p[2]) + m[7];
+            const float z = ((m[8] * p[0] + m[9] * p[1]) + m[10] * p[2]) + m[11];
+            out[0] = x; out[1] = y; out[2] = z;
+        }
+
+        inline void transformNormal(const std::array<float, 9>& n, const float v[3], float out[3]) noexcept {
+            const float x = (n[0] * v[0] + n[1] * v[1]) + n[2] * v[2];
+            const float y = (n[3] * v[0] + n[4] * v[1]) + n[5] * v[2];
+            const float z = (n[6] * v[0] + n[7] * v[1]) + n[8] * v[2];
+            const float length = std::sqrt((x * x + y * y) + z * z);
+            const float ux = x / length, uy = y / length, uz = z / length;
+            const bool valid = length > 0.f;
+            out[0] = valid ? ux : 0.f;
+            out[1] = valid ? uy : 0.f;
+            out[2] = valid ? uz : 0.f;
+        }
+
+#if defined(OPENSTL_SIMD_AVX2) || defined(OPENSTL_SIMD_SSE2)
+        /** @brief transformPoint over 4 points given as x, y and z vectors, in place. */
+        inline void transformPoints4(const __m128 (&m)[12], __m128& x, __m128& y, __m128& z) noexcept {
+            const __m128 tx = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m[0], x), _mm_mul_ps(m[1], y)),
+                                                    _mm_mul_ps(m[2], z)), m[3]);
+            const __m128 ty = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m[4], x), _mm_mul_ps(m[5], y)),
+                                                    _mm_mul_ps(m[6], z)), m[7]);
+            const __m128 tz = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m[8], x), _mm_mul_ps(m[9], y)),
+                                                    _mm_mul_ps(m[10], z)), m[11]);
+            x = tx; y = ty; z = tz;
+        }
+
+        /** @brief transformNormal over 4 normals given as x, y and z vectors, in place. */
+        inline void transformNormals4(const __m128 (&n)[9], __m128& x, __m128& y, __m128& z) noexcept {
+            const __m128 tx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(n[0], x), _mm_mul_ps(n[1], y)), _mm_mul_ps(n[2], z));
+            const __m128 ty = _mm_add_ps(_mm_add_ps(_mm_mul_ps(n[3], x), _mm_mul_ps(n[4], y)), _mm_mul_ps(n[5], z));
+            const __m128 tz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(n[6], x), _mm_mul_ps(n[7], y)), _mm_mul_ps(n[8], z));
+            const __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, tx), _mm_mul_ps(ty, ty)),
+                                                         _mm_mul_ps(tz, tz)));
+            const __m128 valid = _mm_cmpgt_ps(length, _mm_setzero_ps());
+            x = _mm_and_ps(valid, _mm_div_ps(tx, length));
+            y = _mm_and_ps(valid, _mm_div_ps(ty, length));
+            z = _mm_and_ps(valid, _mm_div_ps(tz, length));
+        }
+#endif
+
+        inline void transformTriangleRange(unsigned char* bytes, std::size_t first, std::size_t last,
+                                           std::size_t stride, const AffineMatrix& m,
+                                           const std::array<float, 9>& n) noexcept {
+            std::size_t i{first};
+#if defined(OPENSTL_SIMD_AVX2) || defined(OPENSTL_SIMD_SSE2)
+            __m128 mv[12], nv[9];
+            for (std::size_t k = 0; k < 12u; ++k) mv[k] = _mm_set1_ps(m[k]);
+            for (std::size_t k = 0; k < 9u; ++k) nv[k] = _mm_set1_ps(n[k]);
+            for (; i + 4u <= last; i += 4u) {
+                __m128 c[12];
+                loadRecords4(bytes + i * stride, stride, c);
+                transformNormals4(nv, c[0], c[1], c[2]);
+                transformPoints4(mv, c[3], c[4], c[5]);
+                transformPoints4(mv, c[6], c[7], c[8]);
+                transformPoints4(mv, c[9], c[10], c[11]);
+                storeRecords4(bytes + i * stride, stride, c);
+            }
+#endif
+            for (; i < last; ++i) {
+                float values[12];
+                std::memcpy(values, bytes + i * stride, sizeof(values));
+                transformNormal(n, values, values);
+                for (std::size_t corner = 1; corner < 4u; ++corner) transformPoint(m, values + 3 * corner, values + 3 * corner);
+                std::memcpy(bytes + i * stride, values, sizeof(values));
+            }
+        }
+
+        inline void transformVertexRange(unsigned char* bytes, std::size_t first, std::size_t last,
+                                         std::size_t stride, const AffineMatrix& m) noexcept {
+            std::size_t i{first};
+#if defined(OPENSTL_SIMD_AVX2) || defined(OPENSTL_SIMD_SSE2)
+            __m128 mv[12];
+            for (std::size_t k = 0; k < 12u; ++k) mv[k] = _mm_set1_ps(m[k]);
+            if (stride == 3u * sizeof(float)) {
+                // Packed vertices: 4 vertices are exactly 3 vectors, deinterleaved with shuffles
+                for (; i + 4u <= last; i += 4u) {
+                    auto* p = reinterpret_cast<float*>(bytes + i * stride);
+                    const __m128 a = _mm_loadu_ps(p), b = _mm_loadu_ps(p + 4), c = _mm_loadu_ps(p + 8);
+                    const __m128 a03 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 3, 0));
+                    const __m128 b2c1 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2));
+                    const __m128 a1b0 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));
+                    const __m128 b3c2 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+                    const __m128 a2b1 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));
+                    const __m128 c03 = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 3, 0));
+                    __m128 x = _mm_shuffle_ps(a03, b2c1, _MM_SHUFFLE(2, 0, 1, 0));
+                    __m128 y = _mm_shuffle_ps(a1b0, b3c2, _MM_SHUFFLE(2, 0, 2, 0));
+                    __m128 z = _mm_shuffle_ps(a2b1, c03, _MM_SHUFFLE(1, 0, 2, 0));
+                    transformPoints4(mv, x, y, z);
+                    const __m128 x0y0 = _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0));
+                    const __m128 z0x1 = _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0));
+                    const __m128 y1z1 = _mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1));
+                    const __m128 x2y2 = _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2));
+                    const __m128 z2x3 = _mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2));
+                    const __m128 y3z3 = _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3));
+                    _mm_storeu_ps(p, _mm_shuffle_ps(x0y0, z0x1, _MM_SHUFFLE(2, 0, 2, 0)));
+                    _mm_storeu_ps(p + 4, _mm_shuffle_ps(y1z1, x2y2, _MM_SHUFFLE(2, 0, 2, 0)));
+                    _mm_storeu_ps(p + 8, _mm_shuffle_ps(z2x3, y3z3, _MM_SHUFFLE(2, 0, 2, 0)));
+                }
+            } else if (stride >= 4u * sizeof(float)) {
+                // Each vertex is loaded and stored as 16 bytes, which stay within its stride
+                for (; i + 4u <= last; i += 4u) {
+                    unsigned char* p = bytes + i * stride;
+                    __m128 x = _mm_loadu_ps(reinterpret_cast<const float*>(p));
+                    __m128 y = _mm_loadu_ps(reinterpret_cast<const float*>(p + stride));
+                    __m128 z = _mm_loadu_ps(reinterpret_cast<const float*>(p + 2u * stride));
+                    __m128 w = _mm_loadu_ps(reinterpret_cast<const float*>(p + 3u * stride));
+                    _MM_TRANSPOSE4_PS(x, y, z, w);
+                    transformPoints4(mv, x, y, z);
+                    _MM_TRANSPOSE4_PS(x, y, z, w);
+                    _mm_storeu_ps(reinterpret_cast<float*>(p), x);
+                    _mm_storeu_ps(reinterpret_cast<float*>(p + stride), y);
+                    _mm_storeu_ps(reinterpret_cast<float*>(p + 2u * stride), z);
+                    _mm_storeu_ps(reinterpret_cast<float*>(p + 3u * stride), w);
+                }
+            }
+#endif
+            for (; i < last; ++i) {
+                float p[3];
+                std::memcpy(p, bytes + i * stride, sizeof(p));
+                transformPoint(m, p, p);
+                std::memcpy(bytes + i * stride, p, sizeof(p));
+            }
+        }
+    } //namespace detail
+
+    /**
+     * @brief Apply an affine transform in place to triangle records.
+     *
+     * Vertices are transformed by the matrix. Normals are transformed by the inverse-transpose of its linear
+     * part and normalized, so that they stay perpendicular to the faces under non-uniform scaling; zero
+     * normals stay zero. A mirroring transform (negative determinant) keeps the normals on the same side of
+     * the surface but reverses the winding of the vertices relative to them.
+     *
+     * Records are laid out as for computeNormals and processed in chunks on numThreads threads, 4 at a
+     * time with SSE2 when available.
+     * @param records The first record, not necessarily aligned.
+     * @param count The number of records.
+     * @param stride The distance between two records, in bytes, at least 48.
+     * @param matrix The affine transform.
+     * @param numThreads The maximum number of threads (0: one per hardware core).
+     */
+    inline void transformTriangles(void* records, std::size_t count, std::size_t stride, const AffineMatrix& matrix,
+                                   std::size_t numThreads = 1) {
+        OPENSTL_TIMED_SCOPE("transformTriangles");
+        auto* bytes = static_cast<unsigned char*>(records);
+        const auto normal = detail::normalMatrix(matrix);
+        const std::size_t chunkCount = (count + detail::TRANSFORM_CHUNK_SIZE - 1u) / detail::TRANSFORM_CHUNK_SIZE;
+        parallelFor(chunkCount, numThreads, [&](std::size_t chunk) {
+            const std::size_t first = chunk * detail::TRANSFORM_CHUNK_SIZE;
+            const std::size_t last = std::min(count, first + detail::TRANSFORM_CHUNK_SIZE);
+            detail::transformTriangleRange(bytes, first, last, stride, matrix, normal);
+        });
+    }
+
+    /**
+     * @brief Apply an affine transform in place to contiguous triangles, see
+     * transformTriangles(void*, size_t, size_t, const AffineMatrix&, size_t).
+     */
+    template<typename Container>
+    inline void transformTriangles(Container& triangles, const AffineMatrix& matrix, std::size_t numThreads = 1) {
+        static_assert(detail::HasMutableContiguousTriangles<Container>::value,
+                      "The triangles must be stored contiguously and be writable");
+        transformTriangles(triangles.data(), static_cast<std::size_t>(triangles.size()), sizeof(Triangle), matrix,
+                           numThreads);
+    }
+
+    /**
+     * @brief Apply an affine transform in place to TriangleArrays, with the same results as the record
+     * overload. The per-component loops autovectorize.
+     */
+    inline void transformTriangles(TriangleArrays& arrays, const AffineMatrix& m, std::size_t numThreads = 1) {
+        const auto n = detail::normalMatrix(m);
+        const std::size_t count = arrays.size();
+        const std::size_t chunkCount = (count + detail::TRANSFORM_CHUNK_SIZE - 1u) / detail::TRANSFORM_CHUNK_SIZE;
+        parallelFor(chunkCount, numThreads, [&](std::size_t chunk) {
+            const std::size_t first = chunk * detail::TRANSFORM_CHUNK_SIZE;
+            const std::size_t last = std::min(count, first + detail::TRANSFORM_CHUNK_SIZE);
+            float* nx = arrays.normal(0); float* ny = arrays.normal(1); float* nz = arrays.normal(2);
+            for (std::size_t i = first; i < last; ++i) {
+                const float x = (n[0] * nx[i] + n[1] * ny[i]) + n[2] * nz[i];
+                const float y = (n[3] * nx[i] + n[4] * ny[i]) + n[5] * nz[i];
+                const float z = (n[6] * nx[i] + n[7] * ny[i]) + n[8] * nz[i];
+                const float length = std::sqrt((x * x + y * y) + z * z);
+                const float ux = x / length, uy = y / length, uz = z / length;
+                const bool valid = length > 0.f;
+                nx[i] = valid ? ux : 0.f;
+                ny[i] = valid ? uy : 0.f;
+                nz[i] = valid ? uz : 0.f;
+            }
+            for (std::size_t corner = 0; corner < 3u; ++corner) {
+                float* px = arrays.vertex(corner, 0); float* py = arrays.vertex(corner, 1); float* pz = arrays.vertex(corner, 2);
+                for (std::size_t i = first; i < last; ++i) {
+                    const float x = px[i], y = py[i], z = pz[i];
+                    px[i] = ((m[0] * x + m[1] * y) + m[2] * z) + m[3];
+                    py[i] = ((m[4] * x + m[5] * y) + m[6] * z) + m[7];
+                    pz[i] = ((m[8] * x + m[9] * y) + m[10] * z) + m[11];
+                }
+            }
+        });
+    }
+
+    /**
+     * @brief Apply an affine transform in place to vertices.
+     *
+     * Vertices hold 3 consecutive floats, stride bytes apart: 12 for Vec3 storage or a (N,3) float array.
+     * They are processed in chunks on numThreads threads, 4 at a time with SSE2 when available.
+     * @param vertices The first vertex, not necessarily aligned.
+     * @param count The number of vertices.
+     * @param stride The distance between two vertices, in bytes, at least 12.
+     * @param matrix The affine transform.
+     * @param numThreads The maximum number of threads (0: one per hardware core).
+     */
+    inline void transformVertices(void* vertices, std::size_t count, std::size_t stride, const AffineMatrix& matrix,
+                                  std::size_t numThreads = 1) {
+        OPENSTL_TIMED_SCOPE("transformVertices");
+        auto* bytes = static_cast<unsigned char*>(vertices);
+        const std::size_t chunkCount = (count + detail::TRANSFORM_CHUNK_SIZE - 1u) / detail::TRANSFORM_CHUNK_SIZE;
+        parallelFor(chunkCount, numThreads, [&](std::size_t chunk) {
+            const std::size_t first = chunk * detail::TRANSFORM_CHUNK_SIZE;
+            const std::size_t last = std::min(count, first + detail::TRANSFORM_CHUNK_SIZE);
+            detail::transformVertexRange(bytes, first, last, stride, matrix);
+        });
+    }
+
+    /**
+     * @brief Apply an affine transform in place to a contiguous container of Vec3, see
+     * transformVertices(void*, size_t, size_t, const AffineMatrix&, size_t).
+     */
+    template<typename Container>
+    inline void transformVertices(Container& vertices, const AffineMatrix& matrix, std::size_t numThreads = 1) {
+        static_assert(std::is_convertible<decltype(vertices.data()), Vec3*>::value,
+                      "The vertices must be stored contiguously");
+        transformVertices(vertices.data(), static_cast<std::size_t>(vertices.size()), sizeof(Vec3), matrix,
+                          numThreads);
+    }
+
+    //---------------------------------------------------------------------------------------------------------
+    // Statistics Utils
+    //---------------------------------------------------------------------------------------------------------
+    /**
+     * @brief Global measures of a triangle mesh.
+     */
+    struct MeshStats {
+        BoundingBox bounds{};               ///< Bounds of the vertices, NaN coordinates ignored.
+        Vec3 centroid{0.f, 0.f, 0.f};       ///< Area-weighted centroid of the surface, zero without area.
+        double area{0.0};                   ///< Total surface area.
+        double signed_volume{0.0};          ///< Enclosed volume, positive when the winding faces outward.
+        std::size_t triangle_count{0};      ///< Number of triangles, degenerate ones included.
+        std::size_t degenerate_count{0};    ///< Triangles with a zero or NaN area, left out of the sums.
+    };
+
+    /**
+     * @brief Accumulate MeshStats over triangles given in any number of batches, e.g. from forEachTriangleBatch.
+     *
+     * Per-triangle terms are computed in single precision, 4 triangles at a time with SSE2 when available,
+     * and summed in double precision. Batches are split in fixed chunks whose sums are merged in order, so
+     * that the result does not depend on the number of threads.
+     */
+    class MeshStatsAccumulator {
+    public:
+        static constexpr std::size_t CHUNK_SIZE = std::size_t{1} << 14u;
+
+        /**
+         * @brief Add triangle records, laid out as for computeNormals; the stored normals are ignored.
+         * @param records The first record, not necessarily aligned.
+         * @param count The number of records.
+         * @param stride The distance between two records, in bytes, at least 48.
+         * @param numThreads The maximum number of threads (0: one per hardware core).
+         */
+        void add(const void* records, std::size_t count, std::size_t stride, std::size_t numThreads = 1) {
+            OPENSTL_TIMED_SCOPE("MeshStatsAccumulator::add");
+            const auto* bytes = static_cast<const unsigned char*>(records);
+            const std::size_t chunkCount = (count + CHUNK_SIZE - 1u) / CHUNK_SIZE;
+            if (chunkCount <= 1u) {
+                accumulate(bytes, 0u, count, stride);
+                return;
+            }
+            std::vector<MeshStatsAccumulator> partials(chunkCount);
+            parallelFor(chunkCount, numThreads, [&](std::size_t chunk) {
+                partials[chunk].accumulate(bytes, chunk * CHUNK_SIZE, std::min(count, (chunk + 1u) * CHUNK_SIZE), stride);
+            });
+            for (const auto& partial : partials) merge(partial);
+        }
+
+        /** @brief Add a single triangle. */
+        void add(const Vec3& v0, const Vec3& v1, const Vec3& v2) noexcept {
+            const float vertices[9] = {v0.x, v0.y, v0.z, v1.x, v1.y, v1.z, v2.x, v2.y, v2.z};
+            accumulateTriangle(vertices);
+        }
+
+        /** @brief Add the triangles accumulated by another accumulator. */
+        void merge(const MeshStatsAccumulator& other) noexcept {
+            const Vec3 corners[2] = {other.bounds_.lower, other.bounds_.upper};
+            for (const auto& corner : corners) extendBounds(corner.x, corner.y, corner.z);
+            area2_ += other.area2_;
+            volume6_ += other.volume6_;
+            for (std::size_t axis = 0; axis < 3u; ++axis) weighted_[axis] += other.weighted_[axis];
+            triangles_ += other.triangles_;
+            degenerate_ += other.degenerate_;
+        }
+
+        /** @brief The statistics of the triangles added so far. */
+        MeshStats stats() const noexcept {
+            MeshStats stats{};
+            stats.bounds = bounds_;
+            if (area2_ > 0.0) {
+                stats.centroid = {static_cast<float>(weighted_[0] / (3.0 * area2_)),
+                                  static_cast<float>(weighted_[1] / (3.0 * area2_)),
+                                  static_cast<float>(weighted_[2] / (3.0 * area2_))};
+            }
+            stats.area = area2_ / 2.0;
+            stats.signed_volume = volume6_ / 6.0;
+            stats.triangle_count = triangles_;
+            stats.degenerate_count = degenerate_;
+            return stats;
+        }
+
+    private:
+        void extendBounds(float x, float y, float z) noexcept {
+            bounds_.lower = {x < bounds_.lower.x ? x : bounds_.lower.x, y < bounds_.lower.y ? y : bounds_.lower.y,
+                             z < bounds_.lower.z ? z : bounds_.lower.z};
+            bounds_.upper = {x > bounds_.upper.x ? x : bounds_.upper.x, y > bounds_.upper.y ? y : bounds_.upper.y,
+                             z > bounds_.upper.z ? z : bounds_.upper.z};
+        }
+
+        /** @brief Accumulate one triangle given as v0, v1 and v2, with the same terms as the vectorized path. */
+        void accumulateTriangle(const float v[9]) noexcept {
+            for (std::size_t corner = 0; corner < 3u; ++corner) extendBounds(v[3 * corner], v[3 * corner + 1], v[3 * corner + 2]);
+            const float ax = v[3] - v[0], ay = v[4] - v[1], az = v[5] - v[2];
+            const float bx = v[6] - v[0], by = v[7] - v[1], bz = v[8] - v[2];
+            const float cx = ay * bz - az * by, cy = az * bx - ax * bz, cz = ax * by - ay * bx;
+            const float length = std::sqrt((cx * cx + cy * cy) + cz * cz);
+            ++triangles_;
+            if (!(length > 0.f)) {
+                ++degenerate_;
+                return;
+            }
+            area2_ += length;
+            volume6_ += (v[0] * cx + v[1] * cy) + v[2] * cz;
+            for (std::size_t axis = 0; axis < 3u; ++axis) weighted_[axis] += length * ((v[axis] + v[3 + axis]) + v[6 + axis]);
+        }
+
+        void accumulate(const unsigned char* bytes, std::size_t first, std::size_t last, std::size_t stride) noexcept {
+            std::size_t i{first};
+#if defined(OPENSTL_SIMD_AVX2) || defined(OPENSTL_SIMD_SSE2)
+            const float inf = std::numeric_limits<float>::infinity();
+            __m128 lower[3] = {_mm_set1_ps(inf), _mm_set1_ps(inf), _mm_set1_ps(inf)};
+            __m128 upper[3] = {_mm_set1_ps(-inf), _mm_set1_ps(-inf), _mm_set1_ps(-inf)};
+            __m128d sums[5][2]; // Twice the area, 6 times the volume, weighted x, y and z; low and high lanes
+            for (auto& sum : sums) sum[0] = sum[1] = _mm_setzero_pd();
+            std::size_t degenerate{0};
+            auto add = [](__m128d (&sum)[2], __m128 terms) {
+                sum[0] = _mm_add_pd(sum[0], _mm_cvtps_pd(terms));
+                sum[1] = _mm_add_pd(sum[1], _mm_cvtps_pd(_mm_movehl_ps(terms, terms)));
+            };
+            for (; i + 4u <= last; i += 4u) {
+                __m128 c[12];
+                detail::loadRecords4(bytes + i * stride, stride, c);
+                for (std::size_t axis = 0; axis < 3u; ++axis) {
+                    lower[axis] = _mm_min_ps(c[9 + axis], _mm_min_ps(c[6 + axis], _mm_min_ps(c[3 + axis], lower[axis])));
+                    upper[axis] = _mm_max_ps(c[9 + axis], _mm_max_ps(c[6 + axis], _mm_max_ps(c[3 + axis], upper[axis])));
+                }
+                const __m128 ax = _mm_sub_ps(c[6], c[3]), ay = _mm_sub_ps(c[7], c[4]), az = _mm_sub_ps(c[8], c[5]);
+                const __m128 bx = _mm_sub_ps(c[9], c[3]), by = _mm_sub_ps(c[10], c[4]), bz = _mm_sub_ps(c[11], c[5]);
+                const __m128 cx = _mm_sub_ps(_mm_mul_ps(ay, bz), _mm_mul_ps(az, by));
+                const __m128 cy = _mm_sub_ps(_mm_mul_ps(az, bx), _mm_mul_ps(ax, bz));
+                const __m128 cz = _mm_sub_ps(_mm_mul_ps(ax, by), _mm_mul_ps(ay, bx));
+                const __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, cx), _mm_mul_ps(cy, cy)),
+                                                             _mm_mul_ps(cz, cz)));
+                const __m128 valid = _mm_cmpgt_ps(length, _mm_setzero_ps());
+                const int mask = _mm_movemask_ps(valid);
+                degenerate += 4u - static_cast<std::size_t>((mask & 1) + ((mask >> 1) & 1) + ((mask >> 2) & 1) + (mask >> 3));
+                add(sums[0], _mm_and_ps(valid, length));
+                add(sums[1], _mm_and_ps(valid, _mm_add_ps(_mm_add_ps(_mm_mul_ps(c[3], cx), _mm_mul_ps(c[4], cy)),
+                                                          _mm_mul_ps(c[5], cz))));
+                for (std::size_t axis = 0; axis < 3u; ++axis) {
+                    const __m128 sum = _mm_add_ps(_mm_add_ps(c[3 + axis], c[6 + axis]), c[9 + axis]);
+                    add(sums[2 + axis], _mm_and_ps(valid, _mm_mul_ps(length, sum)));
+                }
+            }
+            alignas(16) float lo[3][4], hi[3][4];
+            alignas(16) double totals[5][4];
+            for (std::size_t axis = 0; axis < 3u; ++axis) {
+                _mm_store_ps(lo[axis], lower[axis]);
+                _mm_store_ps(hi[axis], upper[axis]);
+            }
+            for (std::size_t lane = 0; lane < 4u; ++lane) {
+                extendBounds(lo[0][lane], lo[1][lane], lo[2][lane]);
+                extendBounds(hi[0][lane], hi[1][lane], hi[2][lane]);
+            }
+            for (std::size_t k = 0; k < 5u; ++k) {
+                _mm_store_pd(totals[k], sums[k][0]);
+                _mm_store_pd(totals[k] + 2, sums[k][1]);
+            }
+            area2_ += (totals[0][0] + totals[0][1]) + (totals[0][2] + totals[0][3]);
+            volume6_ += (totals[1][0] + totals[1][1]) + (totals[1][2] + totals[1][3]);
+            for (std::size_t axis = 0; axis < 3u; ++axis)
+                weighted_[axis] += (totals[2 + axis][0] + totals[2 + axis][1]) + (totals[2 + axis][2] + totals[2 + axis][3]);
+            triangles_ += i - first;
+            degenerate_ += degenerate;
+#endif
+            for (; i < last; ++i) {
+                float vertices[9];
+                std::memcpy(vertices, bytes + i * stride + 3u * sizeof(float), sizeof(vertices));
+                accumulateTriangle(vertices);
+            }
+        }
+
+        BoundingBox bounds_{};
+        double area2_{0.0};          ///< Twice the area
+        double volume6_{0.0};        ///< 6 times the signed volume
+        double weighted_[3]{};       ///< Sum of twice the area times the sum of the vertices, per axis
+        std::size_t triangles_{0};
+        std::size_t degenerate_{0};
+    };
+
+    /**
+     * @brief Compute the statistics of triangle records, see MeshStatsAccumulator::add.
+     */
+    inline MeshStats computeMeshStats(const void* records, std::size_t count, std::size_t stride,
+                                      std::size_t numThreads = 1) {
+        MeshStatsAccumulator accumulator;
+        accumulator.add(records, count, stride, numThreads);
+        return accumulator.stats();
+    }
+
+    /**
+     * @brief Compute the statistics of a container of triangles. Contiguous containers are processed in
+     * parallel chunks, others one triangle at a time.
+     */
+    template<typename Container>
+    inline MeshStats computeMeshStats(const Container& triangles, std::size_t numThreads = 1) {
+        if constexpr (detail::HasContiguousTriangles<Container>::value) {
+            return computeMeshStats(triangles.data(), static_cast<std::size_t>(triangles.size()), sizeof(Triangle),
+                                    numThreads);
+        } else {
+            MeshStatsAccumulator accumulator;
+            for (const auto& tri : triangles) accumulator.add(tri.v0, tri.v1, tri.v2);
+            return accumulator.stats();
+        }
+    }
+
+    /**
+     * @brief Compute the statistics of a mesh given as vertices and faces, without building its triangles.
      *
-     * @tparam Stream The type of the input stream.
-     * @param stream The input stream from which to read the STL data.
-     * @return A vector of triangles representing the geometry from the STL file.
+     * Faces are gathered in small blocks of records, which go through the same kernel as computeMeshStats.
+     * The bounding box covers the referenced vertices only.
+     * @param vertices The container of vertices, with operator[].
+     * @param faces The container of faces, with operator[].
+     * @param numThreads The maximum number of threads (0: one per hardware core).
+     * @throws std::out_of_range if a face index is out of range.
      */
-    template <typename Stream>
-    inline std::vector<Triangle> deserializeStl(Stream& stream)
-    {
-        if (isAscii(stream)) {
-            return deserializeAsciiStl(stream);
-        }
-        return deserializeBinaryStl(stream);
+    template<typename ContainerA, typename ContainerB>
+    inline MeshStats computeIndexedMeshStats(const ContainerA& vertices, const ContainerB& faces,
+                                             std::size_t numThreads = 1) {
+        static_assert(detail::IsIndexable<ContainerA>::value && detail::IsIndexable<ContainerB>::value,
+                      "The vertices and faces must provide operator[]");
+        OPENSTL_TIMED_SCOPE("computeIndexedMeshStats");
+        constexpr std::size_t BLOCK_SIZE = 256;
+        constexpr std::size_t CHUNK_SIZE = MeshStatsAccumulator::CHUNK_SIZE;
+        const std::size_t count = static_cast<std::size_t>(faces.size());
+        const std::size_t vertexCount = static_cast<std::size_t>(vertices.size());
+        const std::size_t chunkCount = (count + CHUNK_SIZE - 1u) / CHUNK_SIZE;
+        std::vector<MeshStatsAccumulator> partials(chunkCount);
+        parallelFor(chunkCount, numThreads, [&](std::size_t chunk) {
+            float block[BLOCK_SIZE * 12u]{}; // Records with zero normals
+            const std::size_t last = std::min(count, (chunk + 1u) * CHUNK_SIZE);
+            for (std::size_t first = chunk * CHUNK_SIZE; first < last; first += BLOCK_SIZE) {
+                const std::size_t size = std::min(BLOCK_SIZE, last - first);
+                for (std::size_t i = 0; i < size; ++i) {
+                    const auto& face = faces[first + i];
+                    for (std::size_t corner = 0; corner < 3u; ++corner) {
+                        const auto index = static_cast<std::size_t>(face[corner]);
+                        if (index >= vertexCount) throw std::out_of_range("Face index out of range");
+                        const Vec3& vertex = vertices[index];
+                        block[12u * i + 3u + 3u * corner] = vertex.x;
+                        block[12u * i + 4u + 3u * corner] = vertex.y;
+                        block[12u * i + 5u + 3u * corner] = vertex.z;
+                    }
+                }
+                partials[chunk].add(block, size, 12u * sizeof(float));
+            }
+        });
+        MeshStatsAccumulator accumulator;
+        for (const auto& partial : partials) accumulator.merge(partial);
+        return accumulator.stats();
     }
 
     //---------------------------------------------------------------------------------------------------------
     // Conversion Utils
     //---------------------------------------------------------------------------------------------------------
-    using Face = std::array<size_t, 3>; // v0, v1, v2
+    template<typename Index>
+    using BasicFace = std::array<Index, 3>; // v0, v1, v2
+
+    using Face = BasicFace<std::size_t>;
+
+    namespace detail {
+        /**
+         * @brief Check that Index represents the indices of count elements.
+         * @throws std::length_error otherwise.
+         */
+        template<typename Index>
+        inline void requireIndexRange(std::size_t count, const char* message) {
+            static_assert(std::is_integral<Index>::value, "The index type must be an integer");
+            if (count != 0u && count - 1u > static_cast<std::size_t>(std::numeric_limits<Index>::max()))
+                throw std::length_error(message);
+        }
+    } //namespace detail
 
     inline bool operator==(const Vec3& rhs, const Vec3& lhs) {
         return std::tie(rhs.x, rhs.y, rhs.z) == std::tie(lhs.x, lhs.y, lhs.z);
     }
 
+    /**
+     * @brief Avalanche the bits of a 64-bit value with the MurmurHash3 finalizer.
+     */
+    inline uint64_t mixHash64(uint64_t h) noexcept {
+        h ^= h >> 33u;
+        h *= 0xFF51AFD7ED558CCDull;
+        h ^= h >> 33u;
+        h *= 0xC4CEB9FE1A85EC53ull;
+        h ^= h >> 33u;
+        return h;
+    }
+
+    /**
+     * @brief Hash a vertex by mixing the bit patterns of its three coordinates.
+     *
+     * Coordinates are combined asymmetrically, so that permuted vertices such as (1,2,3) and (3,2,1) do not
+     * collide, then avalanched with the 64-bit MurmurHash3 finalizer. -0.0 and +0.0 hash identically,
+     * consistently with operator==.
+     */
+    inline uint64_t hashVec3(const Vec3& vertex) noexcept {
+        auto bits = [](float value) {
+            uint32_t b;
+            std::memcpy(&b, &value, sizeof(b));
+            return b == 0x80000000u ? 0u : b;
+        };
+        uint64_t h = (static_cast<uint64_t>(bits(vertex.x)) << 32u) | bits(vertex.y);
+        h ^= static_cast<uint64_t>(bits(vertex.z)) * 0x9E3779B97F4A7C15ull;
+        return mixHash64(h);
+    }
+
     struct Vec3Hash {
         std::size_t operator()(const Vec3& vertex) const {
-            // Combine hashes of x, y, and z using bitwise XOR
-            return std::hash<float>{}(vertex.x) ^ std::hash<float>{}(vertex.y) ^ std::hash<float>{}(vertex.z);
+            return static_cast<std::size_t>(hashVec3(vertex));
+        }
+    };
+
+    /**
+     * @brief Vertex welding engine: an open-addressing hash table assigning a dense index to each distinct
+     * vertex, in order of first insertion.
+     *
+     * Slots only hold indices into a contiguous vertex array, probed linearly, and the table keeps a load
+     * factor below 1/2. Vertices are compared with operator==.
+     */
+    class VertexIndexMap {
+    public:
+        static constexpr std::size_t EMPTY = std::numeric_limits<std::size_t>::max();
+
+        /**
+         * @param expectedVertices An estimate of the number of distinct vertices, used to size the table.
+         */
+        explicit VertexIndexMap(std::size_t expectedVertices = 0) {
+            std::size_t capacity{16};
+            while (capacity < expectedVertices * 2u) capacity *= 2u;
+            slots_.assign(capacity, EMPTY);
+            vertices_.reserve(expectedVertices);
+            OPENSTL_COUNT_ALLOCATION(capacity * sizeof(std::size_t) + expectedVertices * sizeof(Vec3));
+        }
+
+        /**
+         * @brief Find the index of a vertex, inserting it if it is new.
+         * @return The index of the vertex in vertices().
+         */
+        std::size_t insert(const Vec3& vertex) {
+            if ((vertices_.size() + 1u) * 2u > slots_.size()) grow();
+            const std::size_t mask = slots_.size() - 1u;
+            std::size_t probes{1};
+            for (std::size_t slot = static_cast<std::size_t>(hashVec3(vertex)) & mask;;
+                 slot = (slot + 1u) & mask, ++probes) {
+                const std::size_t index = slots_[slot];
+                if (index == EMPTY) {
+                    probes_ += probes;
+                    slots_[slot] = vertices_.size();
+                    vertices_.push_back(vertex);
+                    return slots_[slot];
+                }
+                if (vertices_[index] == vertex) {
+                    probes_ += probes;
+                    return index;
+                }
+            }
+        }
+
+        /** @brief The distinct vertices, in order of first insertion. */
+        const std::vector<Vec3>& vertices() const noexcept { return vertices_; }
+
+        /** @brief Move the distinct vertices out of the map, leaving it empty. */
+        std::vector<Vec3> releaseVertices() {
+            slots_.assign(16u, EMPTY);
+            std::vector<Vec3> vertices{};
+            vertices.swap(vertices_);
+            return vertices;
+        }
+
+        std::size_t size() const noexcept { return vertices_.size(); }
+
+    private:
+        void grow() {
+            slots_.assign(slots_.size() * 2u, EMPTY);
+            OPENSTL_COUNT_ALLOCATION(slots_.size() * sizeof(std::size_t));
+            const std::size_t mask = slots_.size() - 1u;
+            for (std::size_t index = 0; index < vertices_.size(); ++index) {
+                std::size_t slot = static_cast<std::size_t>(hashVec3(vertices_[index])) & mask;
+                while (slots_[slot] != EMPTY) slot = (slot + 1u) & mask;
+                slots_[slot] = index;
+            }
+        }
+
+        std::vector<std::size_t> slots_;
+        std::vector<Vec3> vertices_;
+        instrumentation::LocalCounter probes_{instrumentation::Counter::HashProbes};
+    };
+
+    /**
+     * @brief Tolerance-based vertex welding engine: a vertex is welded to the first inserted vertex lying
+     * within the tolerance (Euclidean distance), otherwise it is assigned a new index.
+     *
+     * Vertices are bucketed in a uniform hash grid whose cells are as large as the tolerance, so that a
+     * lookup only visits the 27 cells around the vertex. Welding is not transitive: each vertex is compared
+     * with the inserted vertices only, not with the vertices welded onto them.
+     */
+    class VertexGridMap {
+    public:
+        static constexpr std::size_t EMPTY = std::numeric_limits<std::size_t>::max();
+
+        /**
+         * @param tolerance The welding distance, strictly positive.
+         * @param expectedVertices An estimate of the number of distinct vertices, used to size the table.
+         */
+        explicit VertexGridMap(float tolerance, std::size_t expectedVertices = 0)
+                : tolerance_{tolerance}, inverseCellSize_{1.0 / static_cast<double>(tolerance)},
+                  exact_{expectedVertices} {
+            if (!(tolerance > 0.f))
+                throw std::invalid_argument("VertexGridMap: the tolerance must be strictly positive");
+            std::size_t capacity{16};
+            while (capacity < expectedVertices * 2u) capacity *= 2u;
+            slots_.assign(capacity, Slot{});
+            vertices_.reserve(expectedVertices);
+            next_.reserve(expectedVertices);
+        }
+
+        /**
+         * @brief Find the index of the first inserted vertex within the tolerance, inserting the vertex if none.
+         * @return The index of the vertex in vertices().
+         */
+        std::size_t insert(const Vec3& vertex) {
+            // Repeated occurrences of a vertex always resolve to the same index, skip the grid search for them
+            const std::size_t exactIndex = exact_.insert(vertex);
+            if (exactIndex < resolved_.size()) return resolved_[exactIndex];
+            resolved_.push_back(search(vertex));
+            return resolved_.back();
+        }
+
+        /** @brief The distinct vertices, in order of first insertion. */
+        const std::vector<Vec3>& vertices() const noexcept { return vertices_; }
+
+        /** @brief Move the distinct vertices out of the map, leaving it empty. */
+        std::vector<Vec3> releaseVertices() {
+            slots_.assign(16u, Slot{});
+            next_.clear();
+            cellCount_ = 0;
+            exact_.releaseVertices();
+            resolved_.clear();
+            std::vector<Vec3> vertices{};
+            vertices.swap(vertices_);
+            return vertices;
+        }
+
+        std::size_t size() const noexcept { return vertices_.size(); }
+
+    private:
+        struct Cell {
+            int64_t x, y, z;
+        };
+
+        struct Slot {
+            Cell cell{0, 0, 0};
+            std::size_t head{EMPTY}; // Last inserted vertex of the cell
+        };
+
+        std::size_t search(const Vec3& vertex) {
+            const Cell cell = cellOf(vertex);
+            const double squaredTolerance = static_cast<double>(tolerance_) * static_cast<double>(tolerance_);
+            std::size_t found = EMPTY;
+            for (int64_t dz = -1; dz <= 1; ++dz) {
+                for (int64_t dy = -1; dy <= 1; ++dy) {
+                    for (int64_t dx = -1; dx <= 1; ++dx) {
+                        for (std::size_t index = slots_[findSlot({cell.x + dx, cell.y + dy, cell.z + dz})].head;
+                             index != EMPTY; index = next_[index]) {
+                            if (index < found && squaredDistance(vertices_[index], vertex) <= squaredTolerance)
+                                found = index;
+                        }
+                    }
+                }
+            }
+            if (found != EMPTY) return found;
+
+            if ((cellCount_ + 1u) * 2u > slots_.size()) grow();
+            Slot& slot = slots_[findSlot(cell)];
+            if (slot.head == EMPTY) {
+                slot.cell = cell;
+                ++cellCount_;
+            }
+            next_.push_back(slot.head);
+            slot.head = vertices_.size();
+            vertices_.push_back(vertex);
+            return slot.head;
+        }
+
+        Cell cellOf(const Vec3& vertex) const noexcept {
+            auto coordinate = [this](float value) {
+                const double cell = std::floor(static_cast<double>(value) * inverseCellSize_);
+                // Saturate far away coordinates, which keeps the neighbour offsets overflow-free
+                constexpr double LIMIT = 1e18;
+                return static_cast<int64_t>(std::isnan(cell) ? 0.0 : std::min(std::max(cell, -LIMIT), LIMIT));
+            };
+            return {coordinate(vertex.x), coordinate(vertex.y), coordinate(vertex.z)};
+        }
+
+        static uint64_t hashCell(const Cell& cell) noexcept {
+            return mixHash64(static_cast<uint64_t>(cell.x) * 0x9E3779B97F4A7C15ull
+                             ^ static_cast<uint64_t>(cell.y) * 0xC2B2AE3D27D4EB4Full
+                             ^ static_cast<uint64_t>(cell.z) * 0x165667B19E3779F9ull);
+        }
+
+        static double squaredDistance(const Vec3& a, const Vec3& b) noexcept {
+            const double dx = static_cast<double>(a.x) - b.x, dy = static_cast<double>(a.y) - b.y,
+                    dz = static_cast<double>(a.z) - b.z;
+            return dx * dx + dy * dy + dz * dz;
         }
+
+        /** @brief The slot holding the head of the cell's vertex chain, or the empty slot where it belongs. */
+        std::size_t findSlot(const Cell& cell) const noexcept {
+            const std::size_t mask = slots_.size() - 1u;
+            for (std::size_t slot = static_cast<std::size_t>(hashCell(cell)) & mask;; slot = (slot + 1u) & mask) {
+                ++probes_;
+                const Slot& candidate = slots_[slot];
+                if (candidate.head == EMPTY) return slot;
+                if (candidate.cell.x == cell.x && candidate.cell.y == cell.y && candidate.cell.z == cell.z) return slot;
+            }
+        }
+
+        void grow() {
+            std::vector<Slot> slots(slots_.size() * 2u);
+            OPENSTL_COUNT_ALLOCATION(slots.size() * sizeof(Slot));
+            slots.swap(slots_);
+            for (const auto& slot : slots) {
+                if (slot.head != EMPTY) slots_[findSlot(slot.cell)] = slot;
+            }
+        }
+
+        float tolerance_;
+        double inverseCellSize_;
+        std::size_t cellCount_{0};
+        std::vector<Slot> slots_;
+        std::vector<std::size_t> next_; // Next (earlier) vertex in the same cell
+        std::vector<Vec3> vertices_;
+        VertexIndexMap exact_;              // Bit-exact vertices seen so far...
+        std::vector<std::size_t> resolved_; // ...and the index each of them resolved to
+        mutable instrumentation::LocalCounter probes_{instrumentation::Counter::HashProbes};
     };
 
     /**
@@ -429,27 +3233,267 @@ namespace openstl
     }
 
 
+    /**
+     * @brief Order of the vertices output by convertToVerticesAndFaces.
+     */
+    enum class VertexOrder {
+        FirstAppearance, ///< Order in which vertices first appear in the triangles.
+        Morton           ///< Spatial order along a Morton (Z-order) curve over the bounding box.
+    };
+
+    /**
+     * @brief Options controlling how convertToVerticesAndFaces welds vertices.
+     */
+    struct WeldOptions {
+        std::size_t num_threads{1}; ///< Number of threads (0: one per hardware core).
+        VertexOrder vertex_order{VertexOrder::FirstAppearance};
+        float tolerance{0.f};          ///< Absolute welding distance (0: bit-exact welding).
+        float relative_tolerance{0.f}; ///< Welding distance relative to the bounding box diagonal.
+    };
+
+    /**
+     * @brief Interleave the bits of three 21-bit coordinates into a 63-bit Morton code.
+     */
+    inline uint64_t mortonCode(uint32_t x, uint32_t y, uint32_t z) noexcept {
+        auto spread = [](uint64_t v) {
+            v &= 0x1FFFFFu;
+            v = (v | v << 32u) & 0x001F00000000FFFFull;
+            v = (v | v << 16u) & 0x001F0000FF0000FFull;
+            v = (v | v << 8u) & 0x100F00F00F00F00Full;
+            v = (v | v << 4u) & 0x10C30C30C30C30C3ull;
+            v = (v | v << 2u) & 0x1249249249249249ull;
+            return v;
+        };
+        return spread(x) | spread(y) << 1u | spread(z) << 2u;
+    }
+
+    /**
+     * @brief Sort vertices along a Morton curve spanning their bounding box, and remap the faces accordingly.
+     *
+     * Ties (vertices in the same Morton cell) keep their relative order, so that the result is deterministic.
+     */
+    template<typename Index>
+    inline void sortVerticesAlongMortonCurve(std::vector<Vec3>& vertices, std::vector<BasicFace<Index>>& faces,
+                                             std::size_t numThreads = 1) {
+        if (vertices.size() < 2u) return;
+        OPENSTL_TIMED_SCOPE("sortVerticesAlongMortonCurve");
+        Vec3 lower = vertices.front(), upper = vertices.front();
+        for (const auto& v : vertices) {
+            lower = {std::min(lower.x, v.x), std::min(lower.y, v.y), std::min(lower.z, v.z)};
+            upper = {std::max(upper.x, v.x), std::max(upper.y, v.y), std::max(upper.z, v.z)};
+        }
+        constexpr double CELLS = static_cast<double>(0x1FFFFF);
+        auto quantize = [CELLS](float value, float low, float high) {
+            const double extent = static_cast<double>(high) - static_cast<double>(low);
+            if (!(extent > 0.0)) return 0u;
+            const double cell = (static_cast<double>(value) - static_cast<double>(low)) / extent * CELLS;
+            if (!(cell > 0.0)) return 0u; // also maps NaN to the first cell
+            return static_cast<uint32_t>(std::min(cell, CELLS));
+        };
+
+        std::vector<std::pair<uint64_t, std::size_t>> keys(vertices.size());
+        constexpr std::size_t BLOCK_SIZE = std::size_t{1} << 16u;
+        const std::size_t blockCount = (vertices.size() + BLOCK_SIZE - 1u) / BLOCK_SIZE;
+        parallelFor(blockCount, numThreads, [&](std::size_t block) {
+            const std::size_t last = std::min(vertices.size(), (block + 1u) * BLOCK_SIZE);
+            for (std::size_t i = block * BLOCK_SIZE; i < last; ++i) {
+                const auto& v = vertices[i];
+                keys[i] = {mortonCode(quantize(v.x, lower.x, upper.x), quantize(v.y, lower.y, upper.y),
+                                      quantize(v.z, lower.z, upper.z)), i};
+            }
+        });
+        std::sort(keys.begin(), keys.end());
+
+        std::vector<Vec3> sorted(vertices.size());
+        std::vector<Index> newIndex(vertices.size());
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            sorted[i] = vertices[keys[i].second];
+            newIndex[keys[i].second] = static_cast<Index>(i);
+        }
+        vertices.swap(sorted);
+        const std::size_t faceBlockCount = (faces.size() + BLOCK_SIZE - 1u) / BLOCK_SIZE;
+        parallelFor(faceBlockCount, numThreads, [&](std::size_t block) {
+            const std::size_t last = std::min(faces.size(), (block + 1u) * BLOCK_SIZE);
+            for (std::size_t i = block * BLOCK_SIZE; i < last; ++i)
+                for (auto& index : faces[i]) index = newIndex[static_cast<std::size_t>(index)];
+        });
+    }
+
+    namespace detail {
+        /**
+         * @brief Weld vertices on several threads, with the same output as the serial path.
+         *
+         * Vertex references (3 per triangle) are partitioned by the high bits of their hash with a stable
+         * counting sort, so that equal vertices land in the same partition, ordered by reference. Partitions
+         * are welded concurrently, each vertex pointing to the first reference of its value. Those first
+         * references are finally numbered in reference order with a prefix sum, which reproduces the
+         * first-appearance numbering independently of the number of threads.
+         */
+        template<typename Index, typename Container>
+        inline std::tuple<std::vector<Vec3>, std::vector<BasicFace<Index>>>
+        convertToVerticesAndFacesParallel(const Container& triangles, std::size_t numThreads) {
+            OPENSTL_TIMED_SCOPE("convertToVerticesAndFacesParallel");
+            constexpr std::size_t BLOCK_SIZE = std::size_t{1} << 16u;
+            const std::size_t refCount = static_cast<std::size_t>(triangles.size()) * 3u;
+            auto vertexOf = [&triangles](std::size_t ref) {
+                return vertexAt(triangles, ref / 3u, ref % 3u);
+            };
+
+            unsigned partitionBits{0};
+            while ((std::size_t{1} << partitionBits) < numThreads * 8u) ++partitionBits;
+            const std::size_t partitionCount = std::size_t{1} << partitionBits;
+            auto partitionOf = [partitionBits](const Vec3& vertex) {
+                return static_cast<std::size_t>(hashVec3(vertex) >> (64u - partitionBits));
+            };
+
+            // Stable counting sort of the references by partition
+            const std::size_t blockCount = (refCount + BLOCK_SIZE - 1u) / BLOCK_SIZE;
+            std::vector<std::size_t> offsets(blockCount * partitionCount, 0u);
+            parallelFor(blockCount, numThreads, [&](std::size_t block) {
+                std::size_t* counts = &offsets[block * partitionCount];
+                const std::size_t last = std::min(refCount, (block + 1u) * BLOCK_SIZE);
+                for (std::size_t ref = block * BLOCK_SIZE; ref < last; ++ref) ++counts[partitionOf(vertexOf(ref))];
+            });
+            std::vector<std::size_t> partitionBegin(partitionCount + 1u, 0u);
+            std::size_t running{0};
+            for (std::size_t partition = 0; partition < partitionCount; ++partition) {
+                partitionBegin[partition] = running;
+                for (std::size_t block = 0; block < blockCount; ++block) {
+                    const std::size_t count = offsets[block * partitionCount + partition];
+                    offsets[block * partitionCount + partition] = running;
+                    running += count;
+                }
+            }
+            partitionBegin[partitionCount] = running;
+            std::vector<std::size_t> sortedRefs(refCount);
+            parallelFor(blockCount, numThreads, [&](std::size_t block) {
+                std::size_t* cursor = &offsets[block * partitionCount];
+                const std::size_t last = std::min(refCount, (block + 1u) * BLOCK_SIZE);
+                for (std::size_t ref = block * BLOCK_SIZE; ref < last; ++ref)
+                    sortedRefs[cursor[partitionOf(vertexOf(ref))]++] = ref;
+            });
+
+            // Weld each partition, mapping every reference to the first reference of its value
+            std::vector<std::size_t> firstRef(refCount);
+            parallelFor(partitionCount, numThreads, [&](std::size_t partition) {
+                const std::size_t first = partitionBegin[partition], last = partitionBegin[partition + 1u];
+                VertexIndexMap map{(last - first) / 2u};
+                std::vector<std::size_t> firstRefOfIndex;
+                for (std::size_t i = first; i < last; ++i) {
+                    const std::size_t ref = sortedRefs[i];
+                    const std::size_t index = map.insert(vertexOf(ref));
+                    if (index == firstRefOfIndex.size()) firstRefOfIndex.push_back(ref);
+                    firstRef[ref] = firstRefOfIndex[index];
+                }
+            });
+            std::vector<std::size_t>{}.swap(sortedRefs);
+
+            // Number the first references in order with a prefix sum, then resolve the other references
+            std::vector<std::size_t> blockVertices(blockCount + 1u, 0u);
+            parallelFor(blockCount, numThreads, [&](std::size_t block) {
+                const std::size_t last = std::min(refCount, (block + 1u) * BLOCK_SIZE);
+                for (std::size_t ref = block * BLOCK_SIZE; ref < last; ++ref)
+                    blockVertices[block + 1u] += firstRef[ref] == ref;
+            });
+            for (std::size_t block = 0; block < blockCount; ++block) blockVertices[block + 1u] += blockVertices[block];
+
+            requireIndexRange<Index>(blockVertices[blockCount],
+                                     "convertToVerticesAndFaces: too many vertices for the index type");
+            std::vector<Vec3> vertices(blockVertices[blockCount]);
+            std::vector<BasicFace<Index>> faces(triangles.size());
+            OPENSTL_COUNT_ALLOCATION(vertices.size() * sizeof(Vec3) + faces.size() * sizeof(BasicFace<Index>));
+            Index* indices = faces.empty() ? nullptr : faces.front().data();
+            parallelFor(blockCount, numThreads, [&](std::size_t block) {
+                std::size_t index = blockVertices[block];
+                const std::size_t last = std::min(refCount, (block + 1u) * BLOCK_SIZE);
+                for (std::size_t ref = block * BLOCK_SIZE; ref < last; ++ref) {
+                    if (firstRef[ref] != ref) continue;
+                    vertices[index] = vertexOf(ref);
+                    indices[ref] = static_cast<Index>(index++);
+                }
+            });
+            parallelFor(blockCount, numThreads, [&](std::size_t block) {
+                const std::size_t last = std::min(refCount, (block + 1u) * BLOCK_SIZE);
+                for (std::size_t ref = block * BLOCK_SIZE; ref < last; ++ref)
+                    if (firstRef[ref] != ref) indices[ref] = indices[firstRef[ref]];
+            });
+            return std::make_tuple(std::move(vertices), std::move(faces));
+        }
+    } //namespace detail
+
     /**
      * @brief Finds unique vertices from a vector of triangles
+     *
+     * Vertices are welded through a VertexIndexMap and numbered in order of first appearance, or sorted along
+     * a Morton curve if requested by the options. With several threads, the vertices are hash-partitioned
+     * and welded concurrently; the output is identical for any number of threads. The parallel path requires
+     * a container with operator[], others are welded serially.
+     *
+     * With a non-zero tolerance (the larger of options.tolerance and options.relative_tolerance times the
+     * bounding box diagonal), vertices are welded through a VertexGridMap instead, always serially.
+     * @tparam Index The integer type of the face indices, e.g. uint32_t to halve the size of the faces.
      * @param triangles The container of triangles to convert
+     * @param options The welding options
      * @return An tuple containing respectively the vector of vertices and the vector of face indices
+     * @throws std::invalid_argument if a tolerance is negative or NaN
+     * @throws std::length_error if Index cannot represent every vertex
      */
-    template<typename Container>
-    inline std::tuple<std::vector<Vec3>, std::vector<Face>>
-    convertToVerticesAndFaces(const Container& triangles) {
-        const auto& inverseMap = findInverseMap(triangles);
-        auto verticesNum = inverseMap.size();
-        std::vector<Vec3> vertices{}; vertices.reserve(verticesNum);
-        std::vector<Face> faces(triangles.size());
-        std::vector<uint8_t> vertexPositionInFace(triangles.size(), 0u);
-        size_t vertexIdx{0};
-        for(const auto& item : inverseMap) {
-            vertices.emplace_back(item.first);
-            // Multiple faces can have the same vertex index
-            for(const auto faceIdx : item.second)
-                faces[faceIdx][vertexPositionInFace[faceIdx]++] = vertexIdx;
-            ++vertexIdx;
+    template<typename Index = std::size_t, typename Container>
+    inline std::tuple<std::vector<Vec3>, std::vector<BasicFace<Index>>>
+    convertToVerticesAndFaces(const Container& triangles, const WeldOptions& options = {}) {
+        if (!(options.tolerance >= 0.f) || !(options.relative_tolerance >= 0.f))
+            throw std::invalid_argument("convertToVerticesAndFaces: tolerances must be positive or zero");
+        OPENSTL_TIMED_SCOPE("convertToVerticesAndFaces");
+        float tolerance = options.tolerance;
+        const BoundingBox box = options.relative_tolerance > 0.f ? computeBoundingBox(triangles) : BoundingBox{};
+        if (!box.empty()) {
+            const double dx = static_cast<double>(box.upper.x) - box.lower.x,
+                    dy = static_cast<double>(box.upper.y) - box.lower.y,
+                    dz = static_cast<double>(box.upper.z) - box.lower.z;
+            const double diagonal = std::sqrt(dx * dx + dy * dy + dz * dz);
+            tolerance = std::max(tolerance, static_cast<float>(options.relative_tolerance * diagonal));
+        }
+
+        const std::size_t numThreads = resolveThreadCount(options.num_threads);
+        std::vector<Vec3> vertices;
+        std::vector<BasicFace<Index>> faces;
+        // Vertices are numbered in order, so only the index of a new vertex can overflow Index
+        const bool mayOverflow = static_cast<std::size_t>(triangles.size()) * 3u >
+                                 static_cast<std::size_t>(std::numeric_limits<Index>::max());
+        auto weld = [&triangles, &faces, mayOverflow](auto& map) {
+            OPENSTL_TIMED_SCOPE("weldVertices");
+            auto insert = [&map, mayOverflow](const Vec3& vertex) {
+                const std::size_t index = map.insert(vertex);
+                if (mayOverflow && index == map.size() - 1u)
+                    detail::requireIndexRange<Index>(map.size(),
+                                                     "convertToVerticesAndFaces: too many vertices for the index type");
+                return static_cast<Index>(index);
+            };
+            faces.reserve(triangles.size());
+            OPENSTL_COUNT_ALLOCATION(triangles.size() * sizeof(BasicFace<Index>));
+            for (const auto& tri : triangles) {
+                faces.push_back(BasicFace<Index>{insert(tri.v0), insert(tri.v1), insert(tri.v2)});
+            }
+            return map.releaseVertices();
+        };
+        bool welded{false};
+        if (tolerance > 0.f) {
+            VertexGridMap map{tolerance, static_cast<std::size_t>(triangles.size())};
+            vertices = weld(map);
+            welded = true;
+        }
+        if constexpr (detail::IsIndexable<Container>::value) {
+            if (!welded && numThreads > 1u && triangles.size() >= 4096u) {
+                std::tie(vertices, faces) = detail::convertToVerticesAndFacesParallel<Index>(triangles, numThreads);
+                welded = true;
+            }
+        }
+        if (!welded) {
+            VertexIndexMap map{static_cast<std::size_t>(triangles.size())};
+            vertices = weld(map);
         }
+        if (options.vertex_order == VertexOrder::Morton)
+            sortVerticesAlongMortonCurve(vertices, faces, numThreads);
         return std::make_tuple(std::move(vertices), std::move(faces));
     }
 
@@ -462,10 +3506,11 @@ namespace openstl
     }
 
     /**
-     * @brief Convert vertices and faces to triangles.
+     * @brief Convert vertices and faces to triangles, with unit normals following the winding.
      * @param vertices The container of vertices.
-     * @param faces The container of faces.
+     * @param faces The container of faces, of any integer index type; negative indices are out of range.
      * @return A vector of triangles constructed from the vertices and faces.
+     * @throws std::out_of_range if a face index is out of range.
      */
     template<typename ContainerA, typename ContainerB>
     inline std::vector<Triangle> convertToTriangles(const ContainerA& vertices, const ContainerB& faces)
@@ -473,24 +3518,24 @@ namespace openstl
         if (faces.size() == 0)
             return {};
 
+        OPENSTL_TIMED_SCOPE("convertToTriangles");
         std::vector<Triangle> triangles; triangles.reserve(faces.size());
-        auto getVertex = [&vertices](std::size_t index) {
-            return std::next(std::begin(vertices), index);
+        OPENSTL_COUNT_ALLOCATION(faces.size() * sizeof(Triangle));
+        const auto vertexCount = static_cast<std::size_t>(vertices.size());
+        auto getVertex = [&vertices, vertexCount](auto index) {
+            // Negative signed indices wrap around to large values, and are rejected as well
+            if (static_cast<std::size_t>(index) >= vertexCount)
+                throw std::out_of_range("Face index out of range");
+            return std::next(std::begin(vertices), static_cast<std::ptrdiff_t>(index));
         };
-        auto minmax = std::max_element(&std::begin(faces)->at(0), &std::begin(faces)->at(0)+faces.size()*3);
-
-        // Check if the minimum and maximum indices are within the bounds of the vector
-        if (*minmax >= static_cast<int>(vertices.size())) {
-            throw std::out_of_range("Face index out of range");
-        }
 
         for (const auto& face : faces) {
             auto v0 = getVertex(face[0]);
             auto v1 = getVertex(face[1]);
             auto v2 = getVertex(face[2]);
-            const auto normal = crossProduct(*v1 - *v0, *v2 - *v0);
-            triangles.emplace_back(Triangle{normal, *v0, *v1, *v2, 0u});
+            triangles.emplace_back(Triangle{Vec3{0.f, 0.f, 0.f}, *v0, *v1, *v2, 0u});
         }
+        computeNormals(triangles);
         return triangles;
     }
 
@@ -498,65 +3543,574 @@ namespace openstl
     // Topology Utils
     //---------------------------------------------------------------------------------------------------------
     /**
-     * DisjointSet class to manage disjoint sets with union-find.
+     * @brief Union-find over the integers [0, size), with compact Index storage.
+     *
+     * Finds are iterative with path halving. Sets are linked by index: the root of a larger index is attached
+     * below the root of a smaller one, so that parents never increase and the root of every set is its
+     * smallest element, whatever the order of the unions. Since no rank is stored, a parent array of Index
+     * is the only storage.
+     *
+     * Parents are atomics, which plain loads and stores serve in the serial operations. uniteConcurrent
+     * may be called from several threads at once: it links roots with a compare-and-swap and retries when
+     * another thread linked them first, in the manner of Anderson and Woll's wait-free union-find.
+     *
+     * @tparam Index An unsigned integer type able to represent size - 1.
      */
-    class DisjointSet {
-        std::vector<size_t> parent;
-        std::vector<size_t> rank;
+    template<typename Index>
+    class BasicDisjointSet {
+        static_assert(std::is_unsigned<Index>::value, "The index type must be unsigned");
 
     public:
-        explicit DisjointSet(size_t size) : parent(size), rank(size, 0) {
-            for (size_t i = 0; i < size; ++i) parent[i] = i;
+        /**
+         * @brief Create size singleton sets.
+         * @throws std::length_error if Index cannot represent every element.
+         */
+        explicit BasicDisjointSet(std::size_t size) : parent_(new std::atomic<Index>[checkedSize(size)]), size_(size) {
+            for (std::size_t i = 0; i < size; ++i) parent_[i].store(static_cast<Index>(i), std::memory_order_relaxed);
         }
 
-        size_t find(size_t x) {
-            if (parent[x] != x) parent[x] = find(parent[x]);
-            return parent[x];
-        }
+        std::size_t size() const noexcept { return size_; }
 
-        void unite(size_t x, size_t y) {
-            size_t rootX = find(x), rootY = find(y);
-            if (rootX != rootY) {
-                if (rank[rootX] < rank[rootY]) parent[rootX] = rootY;
-                else if (rank[rootX] > rank[rootY]) parent[rootY] = rootX;
-                else {
-                    parent[rootY] = rootX;
-                    ++rank[rootX];
-                }
+        /** @brief The root of the set of x, halving the path on the way. */
+        Index find(Index x) noexcept {
+            Index parent = load(x);
+            while (parent != x) {
+                const Index grandParent = load(parent);
+                parent_[x].store(grandParent, std::memory_order_relaxed);
+                x = grandParent;
+                parent = load(x);
             }
+            return x;
+        }
+
+        /** @brief Merge the sets of x and y. @return Whether they were distinct. */
+        bool unite(Index x, Index y) noexcept {
+            x = find(x);
+            y = find(y);
+            if (x == y) return false;
+            if (x < y) std::swap(x, y);
+            parent_[x].store(y, std::memory_order_relaxed);
+            return true;
         }
 
-        bool connected(size_t x, size_t y) {
+        bool connected(Index x, Index y) noexcept {
             return find(x) == find(y);
         }
+
+        /** @brief find, safe to call concurrently with uniteConcurrent. */
+        Index findConcurrent(Index x) noexcept {
+            while (true) {
+                Index parent = parent_[x].load(std::memory_order_acquire);
+                if (parent == x) return x;
+                const Index grandParent = parent_[parent].load(std::memory_order_acquire);
+                // Shortcut x to its grandparent, unless another thread moved it already
+                if (grandParent != parent)
+                    parent_[x].compare_exchange_weak(parent, grandParent, std::memory_order_acq_rel,
+                                                     std::memory_order_relaxed);
+                x = grandParent;
+            }
+        }
+
+        /** @brief unite, safe to call from several threads at once. @return Whether this call merged the sets. */
+        bool uniteConcurrent(Index x, Index y) noexcept {
+            while (true) {
+                x = findConcurrent(x);
+                y = findConcurrent(y);
+                if (x == y) return false;
+                if (x < y) std::swap(x, y);
+                Index expected = x;
+                if (parent_[x].compare_exchange_strong(expected, y, std::memory_order_acq_rel,
+                                                       std::memory_order_relaxed))
+                    return true;
+            }
+        }
+
+    private:
+        Index load(Index x) const noexcept { return parent_[x].load(std::memory_order_relaxed); }
+
+        /** @brief Reject sizes Index cannot represent, before anything is allocated. */
+        static std::size_t checkedSize(std::size_t size) {
+            if (size != 0u && size - 1u > static_cast<std::size_t>(std::numeric_limits<Index>::max()))
+                throw std::length_error("BasicDisjointSet: too many elements for the index type");
+            return size;
+        }
+
+        std::unique_ptr<std::atomic<Index>[]> parent_;
+        std::size_t size_;
     };
 
     /**
-     * Identifies and groups connected components of faces based on shared vertices.
+     * DisjointSet class to manage disjoint sets with union-find, with 32-bit parents: up to 2^32 elements,
+     * BasicDisjointSet<std::size_t> beyond.
+     */
+    using DisjointSet = BasicDisjointSet<uint32_t>;
+
+    namespace detail {
+        /**
+         * @brief Unite the vertices of every face, on numThreads threads.
+         * @throws std::out_of_range if a face index is out of range.
+         */
+        template<typename Index, typename ContainerB>
+        inline void uniteFaceVertices(BasicDisjointSet<Index>& sets, const ContainerB& faces, std::size_t numThreads) {
+            constexpr std::size_t CHUNK_SIZE = std::size_t{1} << 16u;
+            const std::size_t count = static_cast<std::size_t>(faces.size());
+            auto uniteFace = [&sets](const auto& face, bool concurrent) {
+                for (std::size_t corner = 0; corner < 3u; ++corner) {
+                    if (static_cast<std::size_t>(face[corner]) >= sets.size())
+                        throw std::out_of_range("Face index out of range");
+                }
+                const auto a = static_cast<Index>(face[0]), b = static_cast<Index>(face[1]), c = static_cast<Index>(face[2]);
+                if (concurrent) {
+                    sets.uniteConcurrent(a, b);
+                    sets.uniteConcurrent(a, c);
+                } else {
+                    sets.unite(a, b);
+                    sets.unite(a, c);
+                }
+            };
+            if constexpr (IsIndexable<ContainerB>::value) {
+                const std::size_t chunkCount = (count + CHUNK_SIZE - 1u) / CHUNK_SIZE;
+                if (resolveThreadCount(numThreads) > 1u && chunkCount > 1u) {
+                    parallelFor(chunkCount, numThreads, [&](std::size_t chunk) {
+                        const std::size_t last = std::min(count, (chunk + 1u) * CHUNK_SIZE);
+                        for (std::size_t i = chunk * CHUNK_SIZE; i < last; ++i) uniteFace(faces[i], true);
+                    });
+                    return;
+                }
+            }
+            for (const auto& face : faces) uniteFace(face, false);
+        }
+    } //namespace detail
+
+    /**
+     * @brief A component label per face.
+     */
+    struct ComponentLabels {
+        std::vector<std::size_t> labels;  ///< Component of each face, numbered in order of first appearance.
+        std::size_t component_count{0};
+    };
+
+    /**
+     * @brief Faces grouped by component, in compressed sparse row form.
+     */
+    struct ComponentGroups {
+        std::vector<std::size_t> offsets;     ///< The faces of component c are face_order[offsets[c], offsets[c + 1]).
+        std::vector<std::size_t> face_order;  ///< Face indices by component, increasing within a component.
+    };
+
+    namespace detail {
+        /**
+         * @brief Replace the root of every face by a component number, in order of first appearance.
+         * @param components Labels holding roots in [0, rootCount); numbered in place.
+         */
+        template<typename Index>
+        inline void numberRoots(ComponentLabels& components, std::size_t rootCount) {
+            constexpr Index NO_LABEL = std::numeric_limits<Index>::max();
+            std::vector<Index> rootLabels(rootCount, NO_LABEL);
+            for (auto& label : components.labels) {
+                Index& rootLabel = rootLabels[label];
+                if (rootLabel == NO_LABEL) rootLabel = static_cast<Index>(components.component_count++);
+                label = rootLabel;
+            }
+        }
+
+        template<typename Index, typename ContainerB>
+        inline ComponentLabels labelConnectedComponents(std::size_t vertexCount, const ContainerB& faces,
+                                                        std::size_t numThreads) {
+            constexpr std::size_t CHUNK_SIZE = std::size_t{1} << 16u;
+            BasicDisjointSet<Index> sets{vertexCount};
+            uniteFaceVertices(sets, faces, numThreads);
+
+            ComponentLabels result;
+            const std::size_t count = static_cast<std::size_t>(faces.size());
+            result.labels.resize(count);
+            if constexpr (IsIndexable<ContainerB>::value) {
+                const std::size_t chunkCount = (count + CHUNK_SIZE - 1u) / CHUNK_SIZE;
+                parallelFor(chunkCount, numThreads, [&](std::size_t chunk) {
+                    const std::size_t last = std::min(count, (chunk + 1u) * CHUNK_SIZE);
+                    for (std::size_t i = chunk * CHUNK_SIZE; i < last; ++i)
+                        result.labels[i] = sets.findConcurrent(static_cast<Index>(faces[i][0]));
+                });
+            } else {
+                std::size_t i{0};
+                for (const auto& face : faces) result.labels[i++] = sets.find(static_cast<Index>(face[0]));
+            }
+
+            numberRoots<Index>(result, vertexCount);
+            return result;
+        }
+    } //namespace detail
+
+    /**
+     * @brief Label the faces with their connected component, faces sharing a vertex being connected.
+     *
+     * Vertices are united as in findConnectedComponents, then the root of every face is resolved on
+     * numThreads threads and roots are numbered in order of first appearance.
      *
      * @param vertices A container of vertices.
      * @param faces A container of faces, where each face is a collection of vertex indices.
-     * @return A vector of connected components, where each component is a vector of faces.
+     * @param numThreads The maximum number of threads (0: one per hardware core).
+     * @return The label of every face and the number of components.
+     * @throws std::out_of_range if a face index is out of range.
      */
     template<typename ContainerA, typename ContainerB>
-    inline std::vector<std::vector<Face>>
-    findConnectedComponents(const ContainerA& vertices, const ContainerB& faces) {
-        DisjointSet ds{vertices.size()};
-        for (const auto& tri : faces) {
-            ds.unite(tri[0], tri[1]);
-            ds.unite(tri[0], tri[2]);
+    inline ComponentLabels
+    labelConnectedComponents(const ContainerA& vertices, const ContainerB& faces, std::size_t numThreads = 1) {
+        OPENSTL_TIMED_SCOPE("labelConnectedComponents");
+        const auto vertexCount = static_cast<std::size_t>(vertices.size());
+        // The largest index is reserved as "no label"
+        if (vertexCount < std::size_t{std::numeric_limits<uint32_t>::max()})
+            return detail::labelConnectedComponents<uint32_t>(vertexCount, faces, numThreads);
+        return detail::labelConnectedComponents<std::size_t>(vertexCount, faces, numThreads);
+    }
+
+    /**
+     * @brief Group the faces by component with a counting sort over their labels.
+     * @param components The labels computed by labelConnectedComponents.
+     * @return The CSR offsets (component_count + 1 entries) and the face permutation.
+     */
+    inline ComponentGroups groupByComponent(const ComponentLabels& components) {
+        OPENSTL_TIMED_SCOPE("groupByComponent");
+        ComponentGroups groups;
+        groups.offsets.assign(components.component_count + 1u, 0u);
+        for (const auto label : components.labels) ++groups.offsets[label + 1u];
+        for (std::size_t c = 0; c < components.component_count; ++c) groups.offsets[c + 1u] += groups.offsets[c];
+        groups.face_order.resize(components.labels.size());
+        std::vector<std::size_t> cursor(groups.offsets.begin(), groups.offsets.end() - 1);
+        for (std::size_t face = 0; face < components.labels.size(); ++face)
+            groups.face_order[cursor[components.labels[face]]++] = face;
+        return groups;
+    }
+
+    namespace detail {
+        /** @brief Copy the faces into one vector per component. */
+        template<typename Index, typename ContainerB>
+        inline std::vector<std::vector<BasicFace<Index>>> copyFacesByComponent(const ContainerB& faces,
+                                                                               const ComponentLabels& components) {
+            OPENSTL_TIMED_SCOPE("copyFacesByComponent");
+            std::vector<std::vector<BasicFace<Index>>> result(components.component_count);
+            {
+                std::vector<std::size_t> sizes(components.component_count, 0u);
+                for (const auto label : components.labels) ++sizes[label];
+                for (std::size_t c = 0; c < components.component_count; ++c) result[c].reserve(sizes[c]);
+            }
+            std::size_t i{0};
+            for (const auto& face : faces) {
+                result[components.labels[i++]].push_back(BasicFace<Index>{static_cast<Index>(face[0]),
+                                                                          static_cast<Index>(face[1]),
+                                                                          static_cast<Index>(face[2])});
+            }
+            return result;
+        }
+    } //namespace detail
+
+    /**
+     * Identifies and groups connected components of faces based on shared vertices.
+     *
+     * Vertices are united in a BasicDisjointSet with 32-bit storage when possible, concurrently when
+     * numThreads allows it and the faces provide operator[]. The storage width is picked from the vertex count,
+     * whatever Index. Prefer labelConnectedComponents and groupByComponent, which avoid copying the faces.
+     *
+     * @tparam Index The integer type of the face indices in the result, independent of the union-find storage.
+     * @param vertices A container of vertices.
+     * @param faces A container of faces, where each face is a collection of vertex indices.
+     * @param numThreads The maximum number of threads (0: one per hardware core).
+     * @return A vector of connected components, where each component is a vector of faces, in order of first
+     * appearance.
+     * @throws std::out_of_range if a face index is out of range.
+     * @throws std::length_error if Index cannot represent every vertex.
+     */
+    template<typename Index = std::size_t, typename ContainerA, typename ContainerB>
+    inline std::vector<std::vector<BasicFace<Index>>>
+    findConnectedComponents(const ContainerA& vertices, const ContainerB& faces, std::size_t numThreads = 1) {
+        detail::requireIndexRange<Index>(static_cast<std::size_t>(vertices.size()),
+                                         "findConnectedComponents: too many vertices for the index type");
+        return detail::copyFacesByComponent<Index>(faces, labelConnectedComponents(vertices, faces, numThreads));
+    }
+
+
+    /**
+     * @brief The edges of an indexed mesh and the faces around them, in compressed sparse row form.
+     *
+     * Half-edge h = 3 * f + c runs from corner c of face f to corner (c + 1) % 3. Edges are the distinct
+     * (min, max) vertex pairs of the half-edges, in increasing order, and the half-edges of an edge are stored
+     * contiguously in increasing order. Storage is linear: two Index per half-edge and three per edge.
+     *
+     * @tparam Index An unsigned integer type able to represent the vertex count and three times the face count.
+     */
+    template<typename Index>
+    struct BasicEdgeAdjacency {
+        std::vector<std::array<Index, 2>> edges;  ///< Smaller and larger vertex of every edge.
+        std::vector<Index> offsets;     ///< The half-edges of edge e are half_edges[offsets[e], offsets[e + 1]).
+        std::vector<Index> half_edges;  ///< Half-edges grouped by edge.
+        std::vector<Index> face_edges;  ///< Edge of every half-edge, three per face.
+
+        std::size_t faceCount() const noexcept { return face_edges.size() / 3u; }
+        std::size_t edgeCount() const noexcept { return edges.size(); }
+
+        /** @brief The number of half-edges on edge e: 1 on a boundary, 2 inside a manifold, more otherwise. */
+        std::size_t edgeValence(std::size_t e) const noexcept {
+            return static_cast<std::size_t>(offsets[e + 1u] - offsets[e]);
+        }
+
+        /**
+         * @brief Call visit(neighbor, edge) for every other face sharing an edge with face.
+         *
+         * A neighbor sharing several edges is visited once per edge.
+         */
+        template<typename Visit>
+        void forEachNeighbor(std::size_t face, Visit&& visit) const {
+            for (std::size_t corner = 0; corner < 3u; ++corner) {
+                const std::size_t e = face_edges[3u * face + corner];
+                for (std::size_t i = offsets[e]; i < offsets[e + 1u]; ++i) {
+                    const std::size_t neighbor = half_edges[i] / 3u;
+                    if (neighbor != face) visit(neighbor, e);
+                }
+            }
+        }
+    };
+
+    using EdgeAdjacency = BasicEdgeAdjacency<std::uint32_t>;
+
+    namespace detail {
+        /**
+         * @brief Sort the half-edges by their (min, max) vertex pair and group them by edge.
+         *
+         * A counting sort on the smaller vertex distributes the half-edges into one bucket per vertex; each bucket
+         * is then sorted on the larger vertex, and runs of equal pairs form the edges. This orders the half-edges
+         * as a sort on packed (min, max) keys would, without storing the keys.
+         *
+         * @throws std::length_error if Index cannot represent the mesh.
+         * @throws std::out_of_range if a face index is out of range.
+         */
+        template<typename Index, typename ContainerB>
+        inline BasicEdgeAdjacency<Index> buildEdgeAdjacency(std::size_t vertexCount, const ContainerB& faces,
+                                                           std::size_t numThreads) {
+            OPENSTL_TIMED_SCOPE("buildEdgeAdjacency");
+            constexpr std::size_t FACE_CHUNK_SIZE = std::size_t{1} << 16u;
+            constexpr std::size_t VERTEX_CHUNK_SIZE = std::size_t{1} << 14u;
+            constexpr auto INDEX_MAX = static_cast<std::size_t>(std::numeric_limits<Index>::max());
+            const std::size_t faceCount = static_cast<std::size_t>(faces.size());
+            if (vertexCount > INDEX_MAX || faceCount > INDEX_MAX / 3u)
+                throw std::length_error("buildEdgeAdjacency: mesh too large for the index type");
+            const std::size_t halfEdgeCount = 3u * faceCount;
+            const std::size_t faceChunkCount = (faceCount + FACE_CHUNK_SIZE - 1u) / FACE_CHUNK_SIZE;
+            const std::size_t vertexChunkCount = (vertexCount + VERTEX_CHUNK_SIZE - 1u) / VERTEX_CHUNK_SIZE;
+
+            auto origin = [&faces](std::size_t h) { return static_cast<Index>(faces[h / 3u][h % 3u]); };
+            auto target = [&faces](std::size_t h) {
+                return static_cast<Index>(faces[h / 3u][h % 3u == 2u ? 0u : h % 3u + 1u]);
+            };
+            auto lower = [&](std::size_t h) { return std::min(origin(h), target(h)); };
+            auto upper = [&](std::size_t h) { return std::max(origin(h), target(h)); };
+
+            // Count the half-edges of every bucket, then turn the counts into insertion cursors
+            std::unique_ptr<std::atomic<Index>[]> cursor{new std::atomic<Index>[vertexCount]};
+            for (std::size_t v = 0; v < vertexCount; ++v) cursor[v].store(0u, std::memory_order_relaxed);
+            const bool concurrent = resolveThreadCount(numThreads) > 1u && faceChunkCount > 1u;
+            auto advance = [&cursor, concurrent](Index v) {
+                if (concurrent) return cursor[v].fetch_add(1u, std::memory_order_relaxed);
+                const Index position = cursor[v].load(std::memory_order_relaxed);
+                cursor[v].store(static_cast<Index>(position + 1u), std::memory_order_relaxed);
+                return position;
+            };
+            parallelFor(faceChunkCount, numThreads, [&](std::size_t chunk) {
+                const std::size_t last = std::min(faceCount, (chunk + 1u) * FACE_CHUNK_SIZE);
+                for (std::size_t f = chunk * FACE_CHUNK_SIZE; f < last; ++f) {
+                    const auto& face = faces[f];
+                    for (std::size_t corner = 0; corner < 3u; ++corner) {
+                        if (static_cast<std::size_t>(face[corner]) >= vertexCount)
+                            throw std::out_of_range("Face index out of range");
+                    }
+                    for (std::size_t corner = 0; corner < 3u; ++corner) advance(lower(3u * f + corner));
+                }
+            });
+            std::vector<Index> buckets(vertexCount + 1u);
+            Index sum{0};
+            for (std::size_t v = 0; v < vertexCount; ++v) {
+                buckets[v] = sum;
+                sum = static_cast<Index>(sum + cursor[v].exchange(sum, std::memory_order_relaxed));
+            }
+            buckets[vertexCount] = sum;
+
+            BasicEdgeAdjacency<Index> result;
+            result.half_edges.resize(halfEdgeCount);
+            parallelFor(faceChunkCount, numThreads, [&](std::size_t chunk) {
+                const std::size_t last = std::min(halfEdgeCount, (chunk + 1u) * 3u * FACE_CHUNK_SIZE);
+                for (std::size_t h = chunk * 3u * FACE_CHUNK_SIZE; h < last; ++h)
+                    result.half_edges[advance(lower(h))] = static_cast<Index>(h);
+            });
+            cursor.reset();
+
+            // Sort every bucket on the larger vertex, then the half-edge, and count the edges of each vertex chunk
+            std::vector<std::size_t> chunkEdges(vertexChunkCount + 1u, 0u);
+            parallelFor(vertexChunkCount, numThreads, [&](std::size_t chunk) {
+                const std::size_t last = std::min(vertexCount, (chunk + 1u) * VERTEX_CHUNK_SIZE);
+                std::vector<std::pair<Index, Index>> bucket;
+                std::size_t edgeCount{0};
+                for (std::size_t v = chunk * VERTEX_CHUNK_SIZE; v < last; ++v) {
+                    const std::size_t first = buckets[v], end = buckets[v + 1u];
+                    bucket.clear();
+                    for (std::size_t i = first; i < end; ++i)
+                        bucket.emplace_back(upper(result.half_edges[i]), result.half_edges[i]);
+                    std::sort(bucket.begin(), bucket.end());
+                    for (std::size_t i = 0; i < bucket.size(); ++i) {
+                        result.half_edges[first + i] = bucket[i].second;
+                        if (i == 0u || bucket[i].first != bucket[i - 1u].first) ++edgeCount;
+                    }
+                }
+                chunkEdges[chunk + 1u] = edgeCount;
+            });
+            for (std::size_t chunk = 0; chunk < vertexChunkCount; ++chunk) chunkEdges[chunk + 1u] += chunkEdges[chunk];
+
+            const std::size_t edgeCount = chunkEdges[vertexChunkCount];
+            result.edges.resize(edgeCount);
+            result.offsets.resize(edgeCount + 1u);
+            result.face_edges.resize(halfEdgeCount);
+            parallelFor(vertexChunkCount, numThreads, [&](std::size_t chunk) {
+                const std::size_t last = std::min(vertexCount, (chunk + 1u) * VERTEX_CHUNK_SIZE);
+                std::size_t e = chunkEdges[chunk];
+                for (std::size_t v = chunk * VERTEX_CHUNK_SIZE; v < last; ++v) {
+                    for (std::size_t i = buckets[v]; i < buckets[v + 1u]; ++i) {
+                        const Index h = result.half_edges[i];
+                        const Index other = upper(h);
+                        if (i == buckets[v] || other != result.edges[e - 1u][1]) {
+                            result.edges[e] = {static_cast<Index>(v), other};
+                            result.offsets[e] = static_cast<Index>(i);
+                            ++e;
+                        }
+                        result.face_edges[h] = static_cast<Index>(e - 1u);
+                    }
+                }
+            });
+            result.offsets[edgeCount] = static_cast<Index>(halfEdgeCount);
+            return result;
         }
+    } //namespace detail
 
-        std::vector<std::vector<Face>> result;
-        std::unordered_map<size_t, size_t> rootToIndex;
+    /**
+     * @brief Find the edges of an indexed mesh and the faces sharing them.
+     *
+     * Runs in time and memory linear in the number of faces and vertices. Every step but a prefix sum over
+     * the vertices is split over numThreads threads.
+     *
+     * @tparam Index The index type of the result, 32-bit by default.
+     * @param vertices A container of vertices.
+     * @param faces A container of faces, where each face is a collection of vertex indices.
+     * @param numThreads The maximum number of threads (0: one per hardware core).
+     * @return The edge adjacency of the faces.
+     * @throws std::length_error if Index cannot represent the vertex count or three times the face count.
+     * @throws std::out_of_range if a face index is out of range.
+     */
+    template<typename Index = std::uint32_t, typename ContainerA, typename ContainerB>
+    inline BasicEdgeAdjacency<Index>
+    buildEdgeAdjacency(const ContainerA& vertices, const ContainerB& faces, std::size_t numThreads = 1) {
+        const auto vertexCount = static_cast<std::size_t>(vertices.size());
+        if constexpr (detail::IsIndexable<ContainerB>::value) {
+            return detail::buildEdgeAdjacency<Index>(vertexCount, faces, numThreads);
+        } else {
+            std::vector<Face> indexed;
+            for (const auto& face : faces) {
+                indexed.push_back(Face{static_cast<std::size_t>(face[0]), static_cast<std::size_t>(face[1]),
+                                       static_cast<std::size_t>(face[2])});
+            }
+            return detail::buildEdgeAdjacency<Index>(vertexCount, indexed, numThreads);
+        }
+    }
 
-        for (const auto& tri : faces) {
-            size_t root = ds.find(tri[0]);
-            if (rootToIndex.find(root) == rootToIndex.end()) {
-                rootToIndex[root] = result.size();
-                result.emplace_back();
+    /**
+     * @brief Label the faces with their connected component, faces sharing an edge being connected.
+     *
+     * Unlike labelConnectedComponents, shells touching at a single vertex stay apart. All the faces around
+     * a non-manifold edge are connected.
+     *
+     * @param adjacency The edge adjacency of the faces.
+     * @param numThreads The maximum number of threads (0: one per hardware core).
+     * @return The label of every face, numbered in order of first appearance, and the number of components.
+     */
+    template<typename Index>
+    inline ComponentLabels
+    labelEdgeConnectedComponents(const BasicEdgeAdjacency<Index>& adjacency, std::size_t numThreads = 1) {
+        OPENSTL_TIMED_SCOPE("labelEdgeConnectedComponents");
+        constexpr std::size_t CHUNK_SIZE = std::size_t{1} << 16u;
+        const std::size_t faceCount = adjacency.faceCount();
+        const std::size_t edgeCount = adjacency.edgeCount();
+        const bool concurrent = resolveThreadCount(numThreads) > 1u;
+        BasicDisjointSet<Index> sets{faceCount};
+        parallelFor((edgeCount + CHUNK_SIZE - 1u) / CHUNK_SIZE, numThreads, [&](std::size_t chunk) {
+            const std::size_t last = std::min(edgeCount, (chunk + 1u) * CHUNK_SIZE);
+            for (std::size_t e = chunk * CHUNK_SIZE; e < last; ++e) {
+                const auto face = static_cast<Index>(adjacency.half_edges[adjacency.offsets[e]] / 3u);
+                for (std::size_t i = adjacency.offsets[e] + 1u; i < adjacency.offsets[e + 1u]; ++i) {
+                    const auto neighbor = static_cast<Index>(adjacency.half_edges[i] / 3u);
+                    if (concurrent) sets.uniteConcurrent(face, neighbor);
+                    else sets.unite(face, neighbor);
+                }
             }
-            result[rootToIndex[root]].push_back(tri);
+        });
+
+        ComponentLabels result;
+        result.labels.resize(faceCount);
+        parallelFor((faceCount + CHUNK_SIZE - 1u) / CHUNK_SIZE, numThreads, [&](std::size_t chunk) {
+            const std::size_t last = std::min(faceCount, (chunk + 1u) * CHUNK_SIZE);
+            for (std::size_t f = chunk * CHUNK_SIZE; f < last; ++f)
+                result.labels[f] = sets.findConcurrent(static_cast<Index>(f));
+        });
+        detail::numberRoots<Index>(result, faceCount);
+        return result;
+    }
+
+    /**
+     * @brief Label the faces with their connected component, faces sharing an edge being connected.
+     * @throws std::out_of_range if a face index is out of range.
+     */
+    template<typename ContainerA, typename ContainerB,
+             typename = std::enable_if_t<!std::is_arithmetic<ContainerB>::value>>
+    inline ComponentLabels
+    labelEdgeConnectedComponents(const ContainerA& vertices, const ContainerB& faces, std::size_t numThreads = 1) {
+        const auto vertexCount = static_cast<std::size_t>(vertices.size());
+        const auto faceCount = static_cast<std::size_t>(faces.size());
+        if (vertexCount <= std::size_t{std::numeric_limits<uint32_t>::max()} &&
+            faceCount <= std::size_t{std::numeric_limits<uint32_t>::max()} / 3u)
+            return labelEdgeConnectedComponents(buildEdgeAdjacency<uint32_t>(vertices, faces, numThreads), numThreads);
+        return labelEdgeConnectedComponents(buildEdgeAdjacency<std::size_t>(vertices, faces, numThreads), numThreads);
+    }
+
+    /**
+     * @brief Groups connected components of faces based on shared edges, as findConnectedComponents does
+     * for shared vertices.
+     * @throws std::out_of_range if a face index is out of range.
+     */
+    template<typename Index = std::size_t, typename ContainerA, typename ContainerB>
+    inline std::vector<std::vector<BasicFace<Index>>>
+    findEdgeConnectedComponents(const ContainerA& vertices, const ContainerB& faces, std::size_t numThreads = 1) {
+        detail::requireIndexRange<Index>(static_cast<std::size_t>(vertices.size()),
+                                         "findEdgeConnectedComponents: too many vertices for the index type");
+        return detail::copyFacesByComponent<Index>(faces, labelEdgeConnectedComponents(vertices, faces, numThreads));
+    }
+
+    /**
+     * @brief The edges shared by more than two faces.
+     * @return Indices into adjacency.edges, in increasing order.
+     */
+    template<typename Index>
+    inline std::vector<std::size_t> findNonManifoldEdges(const BasicEdgeAdjacency<Index>& adjacency) {
+        std::vector<std::size_t> result;
+        for (std::size_t e = 0; e < adjacency.edgeCount(); ++e) {
+            if (adjacency.edgeValence(e) > 2u) result.push_back(e);
+        }
+        return result;
+    }
+
+    /**
+     * @brief The edges of a single face, on the border of an open surface.
+     * @return Indices into adjacency.edges, in increasing order.
+     */
+    template<typename Index>
+    inline std::vector<std::size_t> findBoundaryEdges(const BasicEdgeAdjacency<Index>& adjacency) {
+        std::vector<std::size_t> result;
+        for (std::size_t e = 0; e < adjacency.edgeCount(); ++e) {
+            if (adjacency.edgeValence(e) == 1u) result.push_back(e);
         }
         return result;
     }
@@ -3,6 +3,7 @@
 #include <pybind11/numpy.h>
 #include <pybind11/iostream.h>
 #include <memory>
+#include <optional>
 
 #include "openstl/core/stl.h"
 #include "openstl/core/version.h"
@@ -58,20 +59,130 @@ class StridedSpan {
     const PTRTYPE* data_;
     size_t size_;
 public:
+    /// Distance in bytes between consecutive elements, which may be narrower than VALUETYPE
+    static constexpr size_t STRIDE_BYTES = SIZE * sizeof(PTRTYPE);
+
     StridedSpan(const PTRTYPE* data, size_t size) : data_(data), size_(size) {}
 
     Iterator begin() const { return Iterator{data_}; }
     Iterator end() const { return Iterator{data_ + size_ * SIZE}; }
     size_t size() const {return size_;}
     const PTRTYPE* data() const {return data_;}
+    const VALUETYPE& operator[](size_t index) const { return *reinterpret_cast<const VALUETYPE*>(data_ + index * SIZE); }
+};
+
+
+/**
+ * @brief Hand a vector of fixed-size records over to Python as a (N, columns) array, without copying.
+ *
+ * The vector is moved into a capsule owning it, which the array keeps alive as its base.
+ */
+template<typename Scalar, typename T>
+py::array_t<Scalar, py::array::c_style> vectorToArray(std::vector<T>&& values, size_t columns)
+{
+    static_assert(sizeof(T) % sizeof(Scalar) == 0, "Records must be made of whole scalars");
+    OPENSTL_TIMED_SCOPE("python.vectorToArray");
+    if (values.empty())
+        return py::array_t<Scalar, py::array::c_style>({static_cast<size_t>(0), columns});
+    auto* owner = new std::vector<T>(std::move(values));
+    py::capsule base(owner, [](void* ptr) { delete static_cast<std::vector<T>*>(ptr); });
+    return py::array_t<Scalar, py::array::c_style>(
+            {owner->size() * sizeof(T) / sizeof(Scalar) / columns, columns},
+            reinterpret_cast<const Scalar*>(owner->data()), base);
+}
+
+/**
+ * @brief Hand a vector over to Python as a 1-D array, without copying.
+ */
+template<typename T>
+py::array_t<T, py::array::c_style> vectorToArray(std::vector<T>&& values)
+{
+    OPENSTL_TIMED_SCOPE("python.vectorToArray");
+    if (values.empty())
+        return py::array_t<T, py::array::c_style>(static_cast<py::ssize_t>(0));
+    auto* owner = new std::vector<T>(std::move(values));
+    py::capsule base(owner, [](void* ptr) { delete static_cast<std::vector<T>*>(ptr); });
+    return py::array_t<T, py::array::c_style>({owner->size()}, owner->data(), base);
+}
+
+/**
+ * @brief Call visit with a StridedSpan over (M,3) faces, whatever their integer type.
+ *
+ * C-contiguous int32, uint32, int64 and uint64 arrays are viewed in place; other arrays are converted to int64
+ * once. Negative indices are left to the algorithms, which reject them as out of range.
+ */
+template<typename Visit>
+decltype(auto) visitFaces(const py::array &faces, Visit &&visit)
+{
+    auto view = [&](auto zero) -> decltype(auto) {
+        using Index = decltype(zero);
+        OPENSTL_TIMED_SCOPE("python.facesFromArray");
+        const auto buf = py::array_t<Index, py::array::c_style | py::array::forcecast>::ensure(faces);
+        if (!buf)
+            throw py::value_error("The faces must be an array of vertex indices.");
+        return visit(StridedSpan<BasicFace<Index>, 3, Index>{buf.data(), (size_t)buf.shape(0)});
+    };
+    if (py::isinstance<py::array_t<int32_t>>(faces)) return view(int32_t{});
+    if (py::isinstance<py::array_t<uint32_t>>(faces)) return view(uint32_t{});
+    if (py::isinstance<py::array_t<uint64_t>>(faces)) return view(uint64_t{});
+    return view(int64_t{});
+}
+
+/**
+ * @brief A view over the triangle records of an array: either (N,4,3) float32 rows, or (N,) records of the
+ * packed Triangle dtype. Records may be strided along the first axis.
+ */
+struct TriangleRecords {
+    void* data;
+    size_t count;
+    size_t stride; // In bytes
+
+    static TriangleRecords from(const py::array& array, bool writeable) {
+        if (writeable && !array.writeable())
+            throw py::value_error("The triangles array must be writeable.");
+        const bool floatRows = array.dtype().is(py::dtype::of<float>()) && array.ndim() == 3
+                               && array.shape(1) == 4 && array.shape(2) == 3
+                               && array.strides(2) == sizeof(float) && array.strides(1) == sizeof(Vec3);
+        const bool records = array.dtype().is(py::dtype::of<Triangle>()) && array.ndim() == 1;
+        if (!floatRows && !records)
+            throw py::value_error("The triangles must be a (N,4,3) float32 array with contiguous rows, "
+                                  "or a (N,) array of the Triangle dtype.");
+        if (array.shape(0) > 1 && array.strides(0) < static_cast<py::ssize_t>(12 * sizeof(float)))
+            throw py::value_error("The triangle records must be in increasing order, without overlap.");
+        return {const_cast<void*>(array.data()), static_cast<size_t>(array.shape(0)),
+                static_cast<size_t>(array.strides(0))};
+    }
 };
 
+/**
+ * @brief Read a 3x4 affine matrix from a (3,4) or (4,4) array, the latter with a last row of (0, 0, 0, 1), or
+ * from a (3,3) linear transform.
+ */
+AffineMatrix affineMatrixFrom(const py::array_t<double, py::array::c_style | py::array::forcecast>& array) {
+    const bool linear = array.ndim() == 2 && array.shape(0) == 3 && array.shape(1) == 3;
+    const bool affine = array.ndim() == 2 && (array.shape(0) == 3 || array.shape(0) == 4) && array.shape(1) == 4;
+    if (!linear && !affine)
+        throw py::value_error("The matrix must be a (3,3), (3,4) or (4,4) array.");
+    const double* values = array.data();
+    if (array.shape(0) == 4 && !(values[12] == 0.0 && values[13] == 0.0 && values[14] == 0.0 && values[15] == 1.0))
+        throw py::value_error("The last row of a (4,4) matrix must be (0, 0, 0, 1).");
+    AffineMatrix matrix{};
+    const size_t columns = linear ? 3u : 4u;
+    for (size_t row = 0; row < 3u; ++row)
+        for (size_t column = 0; column < columns; ++column)
+            matrix[4u * row + column] = static_cast<float>(values[columns * row + column]);
+    return matrix;
+}
 
 namespace pybind11 { namespace detail {
     template <> struct type_caster<std::vector<Triangle>> {
     public:
     PYBIND11_TYPE_CASTER(std::vector<Triangle>, _("TrianglesArray"));
 
+        /**
+         * Copies the (N,4,3) float rows into the vector: its 50-byte records cannot alias the 48-byte rows. The
+         * bindings of openstl take their inputs as arrays viewed through StridedSpan instead, without copying.
+         */
         bool load(handle src, bool convert)
         {
             if ( (!convert) && (!py::array_t<float, py::array::c_style | py::array::forcecast>::check_(src)) )
@@ -84,40 +195,159 @@ namespace pybind11 { namespace detail {
             if (buf.ndim() != 3 || buf.shape(1) != 4 || buf.shape(2) != 3)
                 return false;
 
-            std::vector<Triangle> triangles{}; triangles.reserve(buf.shape(0));
-            StridedSpan<Triangle, 12, float> stridedIter{buf.data(), (size_t)buf.shape(0)};
-            std::copy(std::begin(stridedIter), std::end(stridedIter),
-                      std::back_inserter(triangles));
-
-            value = triangles;
+            OPENSTL_TIMED_SCOPE("python.trianglesFromArray");
+            // Triangles are 50 bytes wide with their attribute, the (N,4,3) rows only 48
+            value.resize(static_cast<size_t>(buf.shape(0)));
+            const float* src = buf.data();
+            for (size_t i = 0; i < value.size(); ++i) {
+                std::memcpy(&value[i], src + 12 * i, 12 * sizeof(float));
+                value[i].attribute_byte_count = 0u;
+            }
             return true;
         }
 
-        static handle cast(const std::vector<Triangle>& src, return_value_policy /*policy*/, handle /* parent */) {
+        /**
+         * The triangles are compacted in place into contiguous (N,4,3) float rows, dropping the attribute byte
+         * count, and the array takes ownership of the vector's storage: no allocation, no second buffer.
+         */
+        static handle cast(std::vector<Triangle>&& src, return_value_policy /*policy*/, handle /* parent */) {
+            if (src.empty())
+                return py::array_t<float, py::array::c_style>(
+                        {static_cast<size_t>(0), static_cast<size_t>(4), static_cast<size_t>(3)}).release();
+
+            OPENSTL_TIMED_SCOPE("python.trianglesToArray");
+            auto* owner = new std::vector<Triangle>(std::move(src));
+            auto* bytes = reinterpret_cast<char*>(owner->data());
+            // Rows only move towards the front, each one past the end of the previous one
+            for (size_t i = 1; i < owner->size(); ++i)
+                std::memmove(bytes + i * 12 * sizeof(float), bytes + i * sizeof(Triangle), 12 * sizeof(float));
+            py::capsule base(owner, [](void* ptr) { delete static_cast<std::vector<Triangle>*>(ptr); });
             py::array_t<float, py::array::c_style> array(
-                    {static_cast<size_t>(src.size()),
-                     static_cast<size_t>(4), static_cast<size_t>(3)},
-                    {sizeof(Triangle), sizeof(Vec3), sizeof(float)},
-                    (float*)src.data());
+                    {owner->size(), static_cast<size_t>(4), static_cast<size_t>(3)},
+                    reinterpret_cast<const float*>(bytes), base);
             return array.release();
         }
+
+        static handle cast(const std::vector<Triangle>& src, return_value_policy policy, handle parent) {
+            return cast(std::vector<Triangle>(src), policy, parent);
+        }
     };
 }} // namespace pybind11::detail
 
+/**
+ * @brief Expose a memory-mapped STL as a read-only array aliasing the mapping: either a (N,4,3) float array
+ * or, if structured, a (N,) array of the packed Triangle dtype, attribute byte counts included.
+ *
+ * The array owns a copy of the view through a capsule, which keeps the file mapped until the array is released.
+ */
+py::array mappedTrianglesToArray(MappedTriangles&& mapped, bool structured = false)
+{
+    OPENSTL_TIMED_SCOPE("python.mappedTrianglesToArray");
+    auto* owner = new MappedTriangles(std::move(mapped));
+    py::capsule base(owner, [](void* ptr) { delete static_cast<MappedTriangles*>(ptr); });
+    py::array array = structured
+            ? py::array(py::array_t<Triangle>({static_cast<size_t>(owner->size())}, owner->data(), base))
+            : py::array(py::array_t<float>(
+                    {static_cast<size_t>(owner->size()), static_cast<size_t>(4), static_cast<size_t>(3)},
+                    {sizeof(Triangle), sizeof(Vec3), sizeof(float)},
+                    reinterpret_cast<const float*>(owner->data()), base));
+    // The mapping is read-only, writing through the array would fault
+    array.attr("setflags")("write"_a = false);
+    return array;
+}
+
+/**
+ * @brief Hand triangles over to Python as a (N,) array of the packed Triangle dtype, without copying.
+ */
+py::array_t<Triangle> trianglesToStructuredArray(std::vector<Triangle>&& triangles)
+{
+    OPENSTL_TIMED_SCOPE("python.trianglesToStructuredArray");
+    if (triangles.empty())
+        return py::array_t<Triangle>(static_cast<py::ssize_t>(0));
+    auto* owner = new std::vector<Triangle>(std::move(triangles));
+    py::capsule base(owner, [](void* ptr) { delete static_cast<std::vector<Triangle>*>(ptr); });
+    return py::array_t<Triangle>({owner->size()}, owner->data(), base);
+}
+
+/**
+ * @brief Open a STL file for reading, raising a RuntimeError in Python if it cannot be opened.
+ */
+std::ifstream openStlFile(const std::string &filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open())
+        throw std::runtime_error("Unable to open file '" + filename + "'.");
+    return file;
+}
+
+/**
+ * @brief Python iterator yielding the triangles of an STL file as (N,4,3) float batches.
+ *
+ * The C++ reader reuses a fixed-size buffer; each batch is copied into a fresh array handed over to Python.
+ */
+class TriangleBatchIterator {
+public:
+    TriangleBatchIterator(const std::string &filename, size_t batchSize)
+            : file_(openStlFile(filename)), reader_(std::make_unique<StlBatchReader<std::ifstream>>(file_, batchSize)) {}
+
+    py::array_t<float> next() {
+        if (!reader_->next())
+            throw py::stop_iteration();
+
+        const size_t count = reader_->batchCount();
+        py::array_t<float, py::array::c_style> batch({count, static_cast<size_t>(4), static_cast<size_t>(3)});
+        float* dst = batch.mutable_data();
+        const Triangle* src = reader_->batchData();
+        for (size_t i = 0; i < count; ++i)
+            std::memcpy(dst + 12 * i, &src[i], 12 * sizeof(float));
+        return batch;
+    }
+
+private:
+    std::ifstream file_;
+    std::unique_ptr<StlBatchReader<std::ifstream>> reader_;
+};
+
+/**
+ * @brief Write a binary STL file through the raw file writer, reporting failures on stderr.
+ */
+template<typename Container>
+bool writeBinaryFile(const std::string &filename, const Container &triangles)
+{
+    try {
+        py::gil_scoped_release release;
+        writeBinaryStlFile(filename, triangles);
+    } catch (const std::runtime_error &error) {
+        std::cerr << "Error: " << error.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+ReadOptions readOptions(const std::optional<size_t> &max_triangles, const std::optional<size_t> &memory_budget)
+{
+    ReadOptions options;
+    if (max_triangles) options.max_triangles = *max_triangles;
+    if (memory_budget) options.memory_budget = *memory_budget;
+    return options;
+}
 
 void serialize(py::module_ &m) {
-    // Define getter and setter for the activateOverflowSafety option
-    m.def("get_activate_overflow_safety", []() {
-        return activateOverflowSafety();
-    });
-
-    m.def("set_activate_overflow_safety", [](bool value) {
-        if (!value) {
-            py::print("Warning: Deactivating overflow safety may expose the application to potential buffer overflow risks.",
-                      py::module_::import("sys").attr("stderr"));
-        }
-        activateOverflowSafety() = value;
-    });
+    // Deprecated: the binary header count is always validated against the file size, further limits are
+    // given per read with max_triangles and memory_budget
+    auto warnOverflowSafety = []() {
+        if (PyErr_WarnEx(PyExc_DeprecationWarning, "The overflow safety is deprecated and has no effect, pass "
+                         "max_triangles or memory_budget to read instead.", 1) < 0)
+            throw py::error_already_set();
+    };
+    m.def("get_activate_overflow_safety", [warnOverflowSafety]() {
+        warnOverflowSafety();
+        return true;
+    }, "Deprecated, has no effect");
+
+    m.def("set_activate_overflow_safety", [warnOverflowSafety](bool) {
+        warnOverflowSafety();
+    }, "value"_a, "Deprecated, has no effect");
 
     py::enum_<StlFormat>(m, "format")
             .value("ascii", StlFormat::ASCII)
@@ -126,14 +356,9 @@ void serialize(py::module_ &m) {
 
     m.def("write", [](const std::string &filename,
             const py::array_t<float, py::array::c_style | py::array::forcecast> &array,
-            StlFormat format=openstl::StlFormat::Binary){
+            StlFormat format, int precision, size_t num_threads){
+        OPENSTL_TIMED_SCOPE("python.write");
         py::scoped_ostream_redirect stream(std::cerr,py::module_::import("sys").attr("stderr"));
-        std::ofstream file(filename, std::ios::binary);
-        if (!file.is_open()) {
-            std::cerr << "Error: Unable to open file '" << filename << "'." << std::endl;
-            return false;
-        }
-
         auto buf = py::array_t<float, py::array::c_style | py::array::forcecast>::ensure(array);
         if(!buf)
             return false;
@@ -142,29 +367,211 @@ void serialize(py::module_ &m) {
             return false;
 
         StridedSpan<Triangle, 12, float> stridedIter{buf.data(), (size_t)buf.shape(0)};
-        openstl::serialize(stridedIter, file, format);
+        if (format == StlFormat::Binary)
+            return writeBinaryFile(filename, stridedIter);
+
+        std::ofstream file(filename, std::ios::binary);
+        if (!file.is_open()) {
+            std::cerr << "Error: Unable to open file '" << filename << "'." << std::endl;
+            return false;
+        }
+        {
+            py::gil_scoped_release release;
+            openstl::serializeAsciiStlParallel(stridedIter, file, num_threads, precision);
+        }
 
         if (file.fail()) {
             std::cerr << "Error: Failed to write to file '" << filename << "'." << std::endl;
         }
         file.close();
         return true;
-    },"filename"_a, "triangles"_a, "StlFormat"_a=openstl::StlFormat::Binary, "Serialize a STL to a file");
+    },"filename"_a, "triangles"_a, "StlFormat"_a=openstl::StlFormat::Binary, "precision"_a=SHORTEST_PRECISION,
+    "num_threads"_a=1,
+    "Serialize a STL to a file. ASCII numbers are written with the shortest round-trip representation, or "
+    "with the given number of significant digits, formatted on num_threads threads (0: one per core)");
+
+    m.def("read", [](const std::string &filename, bool mmap, std::optional<size_t> max_triangles,
+            std::optional<size_t> memory_budget) -> py::object {
+        OPENSTL_TIMED_SCOPE("python.read");
+        std::ifstream file = openStlFile(filename);
+
+        // ASCII files cannot be aliased, they are always parsed
+        if (mmap && !openstl::isAscii(file)) {
+            file.close();
+            return mappedTrianglesToArray(openstl::mapBinaryStl(filename, readOptions(max_triangles, memory_budget)));
+        }
 
-    m.def("read", [](const std::string &filename) {
-        py::scoped_ostream_redirect stream(std::cerr, py::module_::import("sys").attr("stderr"));
-        std::ifstream file(filename, std::ios::binary);
+        // Deserialize the triangles in either binary or ASCII format
+        return py::cast(openstl::deserializeStl(file, readOptions(max_triangles, memory_budget)));
+    }, "filename"_a, "mmap"_a=false, "max_triangles"_a=py::none(), "memory_budget"_a=py::none(),
+    "Deserialize a STl from a file. With mmap=True, a binary file is memory-mapped and returned as a read-only "
+    "array aliasing the mapping, which stays alive as long as the array. A file of more than max_triangles "
+    "triangles, or whose triangles exceed memory_budget bytes, is rejected before anything is allocated. Raises a "
+    "RuntimeError if the file cannot be opened, is corrupted or exceeds the limits");
+
+    m.def("write_structured", [](const std::string &filename,
+            const py::array_t<Triangle, py::array::c_style> &triangles,
+            StlFormat format){
+        py::scoped_ostream_redirect stream(std::cerr,py::module_::import("sys").attr("stderr"));
+        if (triangles.ndim() != 1) {
+            std::cerr << "Input array cannot be interpreted as a mesh. Shape must be N with the Triangle dtype.\n";
+            return false;
+        }
+        StridedSpan<Triangle, 1, Triangle> span{triangles.data(), (size_t)triangles.shape(0)};
+        if (format == StlFormat::Binary)
+            return writeBinaryFile(filename, span);
+
+        std::ofstream file(filename, std::ios::binary);
         if (!file.is_open()) {
             std::cerr << "Error: Unable to open file '" << filename << "'." << std::endl;
-            return std::vector<openstl::Triangle>{};
+            return false;
         }
+        openstl::serializeAsciiStl(span, file);
 
-        // Deserialize the triangles in either binary or ASCII format
-        return openstl::deserializeStl(file);
-    }, "filename"_a, "Deserialize a STl from a file", py::return_value_policy::move);
+        if (file.fail()) {
+            std::cerr << "Error: Failed to write to file '" << filename << "'." << std::endl;
+            return false;
+        }
+        return true;
+    }, "filename"_a, "triangles"_a, "StlFormat"_a=openstl::StlFormat::Binary,
+    "Serialize a (N,) array of the packed Triangle dtype to a file, attribute byte counts included");
+
+    m.def("read_structured", [](const std::string &filename, bool mmap, std::optional<size_t> max_triangles,
+            std::optional<size_t> memory_budget) -> py::object {
+        std::ifstream file = openStlFile(filename);
+        if (mmap && !openstl::isAscii(file)) {
+            file.close();
+            return mappedTrianglesToArray(openstl::mapBinaryStl(filename, readOptions(max_triangles, memory_budget)),
+                                          true);
+        }
+        return trianglesToStructuredArray(openstl::deserializeStl(file, readOptions(max_triangles, memory_budget)));
+    }, "filename"_a, "mmap"_a=false, "max_triangles"_a=py::none(), "memory_budget"_a=py::none(),
+    "Deserialize a STL from a file as a (N,) array of the packed 50-byte Triangle dtype, whose fields are "
+    "normal, v0, v1, v2 and attribute_byte_count. With mmap=True, a binary file is memory-mapped and returned as "
+    "a read-only array aliasing the mapping. max_triangles and memory_budget bound the read, and errors are "
+    "raised, as in read");
+
+    py::class_<TriangleBatchIterator>(m, "TriangleBatchIterator")
+            .def("__iter__", [](TriangleBatchIterator &self) -> TriangleBatchIterator& { return self; },
+                 py::return_value_policy::reference_internal)
+            .def("__next__", &TriangleBatchIterator::next);
+
+    m.def("read_batches", [](const std::string &filename, size_t batch_size) {
+        return std::make_unique<TriangleBatchIterator>(filename, batch_size);
+    }, "filename"_a, "batch_size"_a=StlBatchReader<std::ifstream>::DEFAULT_BATCH_SIZE,
+    "Iterate over the triangles of a STL file in (N,4,3) batches of at most batch_size triangles, in bounded memory. "
+    "Raises a RuntimeError if the file cannot be opened or read");
+}
+
+
+void normals(py::module_ &m) {
+    m.def("compute_normals", [](const py::array &triangles) {
+        const auto records = TriangleRecords::from(triangles, true);
+        py::gil_scoped_release release;
+        computeNormals(records.data, records.count, records.stride);
+    }, "triangles"_a,
+    "Recompute in place the unit normals of a (N,4,3) float32 array (or a Triangle dtype array) from the "
+    "winding of its vertices: (v1 - v0) x (v2 - v0) normalized, zero for degenerate triangles");
+
+    m.def("find_inconsistent_normals", [](const py::array &triangles, float angle_tolerance) {
+        const auto records = TriangleRecords::from(triangles, false);
+        std::vector<size_t> indices;
+        {
+            py::gil_scoped_release release;
+            indices = findInconsistentNormals(records.data, records.count, records.stride, angle_tolerance);
+        }
+        return vectorToArray(std::move(indices));
+    }, "triangles"_a, "angle_tolerance"_a = DEFAULT_NORMAL_ANGLE_TOLERANCE,
+    "Return the indices of the triangles whose stored normal is zero, or deviates from the normal given by "
+    "their winding by more than angle_tolerance radians. Degenerate triangles are never reported");
 }
 
 
+void transforms(py::module_ &m) {
+    m.def("transform", [](const py::array &triangles,
+                          const py::array_t<double, py::array::c_style | py::array::forcecast> &matrix,
+                          size_t num_threads) {
+        const auto records = TriangleRecords::from(triangles, true);
+        const auto affine = affineMatrixFrom(matrix);
+        py::gil_scoped_release release;
+        transformTriangles(records.data, records.count, records.stride, affine, num_threads);
+    }, "triangles"_a, "matrix"_a, "num_threads"_a = 1,
+    "Apply in place an affine transform, given as a (3,3), (3,4) or (4,4) matrix, to a (N,4,3) float32 array "
+    "(or a Triangle dtype array). Vertices are transformed by the matrix, normals by the inverse-transpose of "
+    "its linear part, then normalized. num_threads=0 uses one thread per core");
+
+    m.def("transform_vertices", [](const py::array &vertices,
+                                   const py::array_t<double, py::array::c_style | py::array::forcecast> &matrix,
+                                   size_t num_threads) {
+        if (!vertices.writeable())
+            throw py::value_error("The vertices array must be writeable.");
+        if (!vertices.dtype().is(py::dtype::of<float>()) || vertices.ndim() != 2 || vertices.shape(1) != 3
+            || vertices.strides(1) != sizeof(float))
+            throw py::value_error("The vertices must be a (N,3) float32 array with contiguous rows.");
+        if (vertices.shape(0) > 1 && vertices.strides(0) < static_cast<py::ssize_t>(sizeof(Vec3)))
+            throw py::value_error("The vertices must be in increasing order, without overlap.");
+        const auto affine = affineMatrixFrom(matrix);
+        py::gil_scoped_release release;
+        transformVertices(const_cast<void*>(vertices.data()), static_cast<size_t>(vertices.shape(0)),
+                          static_cast<size_t>(vertices.strides(0)), affine, num_threads);
+    }, "vertices"_a, "matrix"_a, "num_threads"_a = 1,
+    "Apply in place an affine transform, given as a (3,3), (3,4) or (4,4) matrix, to a (N,3) float32 array "
+    "of vertices. num_threads=0 uses one thread per core");
+}
+
+void statistics(py::module_ &m) {
+    auto tuple3 = [](const Vec3& v) { return py::make_tuple(v.x, v.y, v.z); };
+    py::class_<MeshStats>(m, "MeshStats")
+            .def_property_readonly("lower", [tuple3](const MeshStats &s) { return tuple3(s.bounds.lower); })
+            .def_property_readonly("upper", [tuple3](const MeshStats &s) { return tuple3(s.bounds.upper); })
+            .def_property_readonly("centroid", [tuple3](const MeshStats &s) { return tuple3(s.centroid); })
+            .def_readonly("area", &MeshStats::area)
+            .def_readonly("signed_volume", &MeshStats::signed_volume)
+            .def_readonly("triangle_count", &MeshStats::triangle_count)
+            .def_readonly("degenerate_count", &MeshStats::degenerate_count)
+            .def("__repr__", [](const MeshStats &s) {
+                std::ostringstream out;
+                out << "MeshStats(triangle_count=" << s.triangle_count << ", area=" << s.area
+                    << ", signed_volume=" << s.signed_volume << ", degenerate_count=" << s.degenerate_count << ")";
+                return out.str();
+            });
+
+    py::class_<MeshStatsAccumulator>(m, "MeshStatsAccumulator",
+            "Accumulate mesh statistics over batches of triangles, e.g. from read_batches")
+            .def(py::init<>())
+            .def("add", [](MeshStatsAccumulator &self, const py::array &triangles, size_t num_threads) {
+                const auto records = TriangleRecords::from(triangles, false);
+                py::gil_scoped_release release;
+                self.add(records.data, records.count, records.stride, num_threads);
+            }, "triangles"_a, "num_threads"_a = 1)
+            .def("stats", &MeshStatsAccumulator::stats);
+
+    m.def("mesh_stats", [](const py::array &triangles, size_t num_threads) {
+        const auto records = TriangleRecords::from(triangles, false);
+        py::gil_scoped_release release;
+        return computeMeshStats(records.data, records.count, records.stride, num_threads);
+    }, "triangles"_a, "num_threads"_a = 1,
+    "Compute the bounding box, area-weighted centroid, area, signed volume and degenerate triangle count of a "
+    "(N,4,3) float32 array (or a Triangle dtype array) in one pass");
+
+    m.def("mesh_stats_indexed", [](
+            const py::array_t<float, py::array::c_style | py::array::forcecast> &vertices,
+            const py::array &faces,
+            size_t num_threads) {
+        if (vertices.ndim() != 2 || vertices.shape(1) != 3)
+            throw py::value_error("The vertices must be a (N,3) array.");
+        if (faces.ndim() != 2 || faces.shape(1) != 3)
+            throw py::value_error("The faces must be a (M,3) array.");
+        StridedSpan<Vec3, 3, float> verticesIter{vertices.data(), (size_t)vertices.shape(0)};
+        return visitFaces(faces, [&](const auto &facesIter) {
+            py::gil_scoped_release release;
+            return computeIndexedMeshStats(verticesIter, facesIter, num_threads);
+        });
+    }, "vertices"_a, "faces"_a, "num_threads"_a = 1,
+    "Compute the statistics of a mesh given as vertices and faces, see mesh_stats. Raises IndexError on out of "
+    "range face indices");
+}
+
 namespace openstl
 {
     enum class Convert { VERTICES_AND_FACES=0, TRIANGLES};
@@ -174,12 +581,25 @@ void convertSubmodule(py::module_ &_m)
 {
     auto m = _m.def_submodule("convert", "A submodule to convert mesh representations");
 
+    py::enum_<VertexOrder>(m, "vertex_order")
+            .value("first_appearance", VertexOrder::FirstAppearance)
+            .value("morton", VertexOrder::Morton)
+            .export_values();
+
     m.def("verticesandfaces", [](
-            const py::array_t<float, py::array::c_style | py::array::forcecast> &array
+            const py::array_t<float, py::array::c_style | py::array::forcecast> &array,
+            size_t num_threads,
+            VertexOrder vertex_order,
+            float tolerance,
+            float relative_tolerance,
+            const py::object &index_dtype
     )
-            -> std::tuple<py::array_t<float, py::array::c_style>,
-                    py::array_t<size_t, py::array::c_style>>
+            -> std::tuple<py::array, py::array>
     {
+        OPENSTL_TIMED_SCOPE("python.verticesandfaces");
+        const auto indexType = py::dtype::from_args(index_dtype);
+        if ((indexType.kind() != 'i' && indexType.kind() != 'u') || (indexType.itemsize() != 4 && indexType.itemsize() != 8))
+            throw py::value_error("index_dtype must be int32, uint32, int64 or uint64.");
         py::scoped_ostream_redirect stream(std::cerr,py::module_::import("sys").attr("stderr"));
         auto buf = py::array_t<float, py::array::c_style | py::array::forcecast>::ensure(array);
         if(!buf){
@@ -192,26 +612,37 @@ void convertSubmodule(py::module_ &_m)
         }
 
         StridedSpan<Triangle, 12, float> stridedIter{buf.data(), (size_t)buf.shape(0)};
-        const auto& verticesAndFaces = convertToVerticesAndFaces(stridedIter);
-        const auto& vertices = std::get<0>(verticesAndFaces);
-        const auto& faces = std::get<1>(verticesAndFaces);
-
-        return std::make_tuple(
-                py::array_t<float, py::array::c_style>(
-                        {static_cast<size_t>(vertices.size()),static_cast<size_t>(3)},
-                        {sizeof(Vec3), sizeof(float)},
-                        (const float*)vertices.data()),
-                py::array_t<size_t, py::array::c_style>(
-                        {static_cast<size_t>(faces.size()),static_cast<size_t>(3)},
-                        {sizeof(Face), sizeof(size_t)},
-                        (const size_t*)faces.data())
-        );
-    }, "triangles"_a, "Convert the mesh to a format 'vertices-and-face-indices'");
+        WeldOptions options{};
+        options.num_threads = num_threads;
+        options.vertex_order = vertex_order;
+        options.tolerance = tolerance;
+        options.relative_tolerance = relative_tolerance;
+        auto convert = [&](auto zero) -> std::tuple<py::array, py::array> {
+            using Index = decltype(zero);
+            auto verticesAndFaces = [&] {
+                py::gil_scoped_release release;
+                return convertToVerticesAndFaces<Index>(stridedIter, options);
+            }();
+            return std::make_tuple(
+                    vectorToArray<float>(std::move(std::get<0>(verticesAndFaces)), 3),
+                    vectorToArray<Index>(std::move(std::get<1>(verticesAndFaces)), 3)
+            );
+        };
+        if (indexType.itemsize() == 4)
+            return indexType.kind() == 'u' ? convert(uint32_t{}) : convert(int32_t{});
+        return indexType.kind() == 'u' ? convert(uint64_t{}) : convert(int64_t{});
+    }, "triangles"_a, "num_threads"_a = 1, "vertex_order"_a = VertexOrder::FirstAppearance,
+    "tolerance"_a = 0.f, "relative_tolerance"_a = 0.f, "index_dtype"_a = py::dtype::of<uint64_t>(),
+    "Convert the mesh to a format 'vertices-and-face-indices'. Vertices are numbered in order of first "
+    "appearance, or sorted along a Morton curve with vertex_order=morton; num_threads > 1 (0: one per core) "
+    "welds them in parallel with an identical result. Vertices closer than tolerance, or relative_tolerance "
+    "times the bounding box diagonal, are welded together. index_dtype selects the integer type of the faces, "
+    "e.g. numpy.uint32 to halve their size; a ValueError is raised if it cannot index every vertex.");
 
 
     m.def("triangles", [](
             const py::array_t<float, py::array::c_style | py::array::forcecast> &vertices,
-            const py::array_t<size_t, py::array::c_style | py::array::forcecast> &faces
+            const py::array &faces
     ) -> std::vector<Triangle>
     {
         py::scoped_ostream_redirect stream(std::cerr,py::module_::import("sys").attr("stderr"));
@@ -225,32 +656,41 @@ void convertSubmodule(py::module_ &_m)
             return {};
         }
 
-        auto fbuf = py::array_t<size_t , py::array::c_style | py::array::forcecast>::ensure(faces);
-        if(!fbuf){
-            std::cerr << "Faces input array cannot be interpreted as a mesh.\n";
-            return {};
-        }
-        if (fbuf.ndim() != 2 || vbuf.shape(1) != 3){
+        if (faces.ndim() != 2 || faces.shape(1) != 3){
             std::cerr << "Faces input array cannot be interpreted as a mesh.\n";
             std::cerr << "Shape must be N x 3 (v0, v1, v2).\n";
             return {};
         }
 
         StridedSpan<Vec3,3, float> verticesIter{vbuf.data(), (size_t)vbuf.shape(0)};
-        StridedSpan<Face,3,size_t> facesIter{fbuf.data(), (size_t)fbuf.shape(0)};
-        return convertToTriangles(verticesIter, facesIter);
+        return visitFaces(faces, [&](const auto &facesIter) {
+            return convertToTriangles(verticesIter, facesIter);
+        });
     }, "vertices"_a,"faces"_a, "Convert the mesh from vertices and faces to triangles");
 }
 
+/**
+ * @brief Parse the connectivity of a component query: whether faces must share an edge rather than a vertex.
+ */
+bool sharesEdges(const std::string &connectivity)
+{
+    if (connectivity != "vertex" && connectivity != "edge")
+        throw py::value_error("connectivity must be 'vertex' or 'edge'.");
+    return connectivity == "edge";
+}
+
 void topologySubmodule(py::module_ &_m)
 {
     auto m = _m.def_submodule("topology", "A submodule for analyzing and segmenting connected components in mesh topology.");
 
     m.def("find_connected_components", [](
             const py::array_t<float, py::array::c_style | py::array::forcecast> &vertices,
-            const py::array_t<size_t, py::array::c_style | py::array::forcecast> &faces
+            const py::array &faces,
+            size_t num_threads,
+            const std::string &connectivity
     ) -> std::vector<std::vector<Face>>
     {
+        const bool byEdge = sharesEdges(connectivity);
         py::scoped_ostream_redirect stream(std::cerr,py::module_::import("sys").attr("stderr"));
         auto vbuf = py::array_t<float, py::array::c_style | py::array::forcecast>::ensure(vertices);
         if(!vbuf){
@@ -262,30 +702,156 @@ void topologySubmodule(py::module_ &_m)
             return {};
         }
 
-        auto fbuf = py::array_t<size_t , py::array::c_style | py::array::forcecast>::ensure(faces);
-        if(!fbuf){
+        if (faces.ndim() != 2 || faces.shape(1) != 3){
             std::cerr << "Faces input array cannot be interpreted as a mesh.\n";
+            std::cerr << "Shape must be N x 3 (v0, v1, v2).\n";
             return {};
         }
-        if (fbuf.ndim() != 2 || vbuf.shape(1) != 3){
+
+        StridedSpan<Vec3,3, float> verticesIter{vbuf.data(), (size_t)vbuf.shape(0)};
+        return visitFaces(faces, [&](const auto &facesIter) {
+            py::gil_scoped_release release;
+            return byEdge ? findEdgeConnectedComponents(verticesIter, facesIter, num_threads)
+                          : findConnectedComponents(verticesIter, facesIter, num_threads);
+        });
+    }, "vertices"_a,"faces"_a, "num_threads"_a=1, "connectivity"_a="vertex",
+    "Group the faces in connected components of faces sharing vertices, or edges with connectivity='edge'. "
+    "num_threads=0 uses one thread per core");
+
+    m.def("label_connected_components", [](
+            const py::array_t<float, py::array::c_style | py::array::forcecast> &vertices,
+            const py::array &faces,
+            size_t num_threads,
+            bool return_groups,
+            const std::string &connectivity
+    ) -> py::object
+    {
+        const bool byEdge = sharesEdges(connectivity);
+        py::scoped_ostream_redirect stream(std::cerr,py::module_::import("sys").attr("stderr"));
+        auto vbuf = py::array_t<float, py::array::c_style | py::array::forcecast>::ensure(vertices);
+        if(!vbuf || vbuf.ndim() != 2 || vbuf.shape(1) != 3){
+            std::cerr << "Vertices input array cannot be interpreted as a mesh. Shape must be N x 3.\n";
+            return py::none();
+        }
+        if(faces.ndim() != 2 || faces.shape(1) != 3){
             std::cerr << "Faces input array cannot be interpreted as a mesh.\n";
             std::cerr << "Shape must be N x 3 (v0, v1, v2).\n";
-            return {};
+            return py::none();
         }
 
         StridedSpan<Vec3,3, float> verticesIter{vbuf.data(), (size_t)vbuf.shape(0)};
-        StridedSpan<Face,3,size_t> facesIter{fbuf.data(), (size_t)fbuf.shape(0)};
-        return findConnectedComponents(verticesIter, facesIter);
-    }, "vertices"_a,"faces"_a, "Convert the mesh from vertices and faces to triangles");
+        ComponentLabels components;
+        ComponentGroups groups;
+        visitFaces(faces, [&](const auto &facesIter) {
+            py::gil_scoped_release release;
+            components = byEdge ? labelEdgeConnectedComponents(verticesIter, facesIter, num_threads)
+                                : labelConnectedComponents(verticesIter, facesIter, num_threads);
+            if (return_groups)
+                groups = groupByComponent(components);
+        });
+        auto labels = vectorToArray(std::move(components.labels));
+        if (!return_groups)
+            return std::move(labels);
+        return py::make_tuple(labels,
+                              vectorToArray(std::move(groups.offsets)),
+                              vectorToArray(std::move(groups.face_order)));
+    }, "vertices"_a,"faces"_a, "num_threads"_a=1, "return_groups"_a=false, "connectivity"_a="vertex",
+    "Label each face with the index of its connected component, numbered by first appearance. "
+    "With return_groups=True, also return (offsets, face_order) listing the faces of component k "
+    "as face_order[offsets[k]:offsets[k+1]]. Faces sharing a vertex are connected, or faces sharing an edge "
+    "with connectivity='edge'. num_threads=0 uses one thread per core");
+
+    m.def("edge_adjacency", [](
+            const py::array_t<float, py::array::c_style | py::array::forcecast> &vertices,
+            const py::array &faces,
+            size_t num_threads) {
+        if (vertices.ndim() != 2 || vertices.shape(1) != 3)
+            throw py::value_error("The vertices must be a (N,3) array.");
+        if (faces.ndim() != 2 || faces.shape(1) != 3)
+            throw py::value_error("The faces must be a (M,3) array.");
+        StridedSpan<Vec3, 3, float> verticesIter{vertices.data(), (size_t)vertices.shape(0)};
+        EdgeAdjacency adjacency;
+        std::vector<std::size_t> nonManifold, boundary;
+        visitFaces(faces, [&](const auto &facesIter) {
+            py::gil_scoped_release release;
+            adjacency = buildEdgeAdjacency(verticesIter, facesIter, num_threads);
+            nonManifold = findNonManifoldEdges(adjacency);
+            boundary = findBoundaryEdges(adjacency);
+        });
+        py::dict result;
+        result["edges"] = vectorToArray<uint32_t>(std::move(adjacency.edges), 2);
+        result["offsets"] = vectorToArray(std::move(adjacency.offsets));
+        result["half_edges"] = vectorToArray(std::move(adjacency.half_edges));
+        result["face_edges"] = vectorToArray(std::move(adjacency.face_edges));
+        result["non_manifold_edges"] = vectorToArray(std::move(nonManifold));
+        result["boundary_edges"] = vectorToArray(std::move(boundary));
+        return result;
+    }, "vertices"_a, "faces"_a, "num_threads"_a = 1,
+    "Find the edges of a mesh and the faces around them. Returns a dict of uint32 arrays: 'edges' (E,2) holds the "
+    "sorted (min, max) vertices of every edge; half-edge h = 3 * face + corner runs from corner to corner + 1, and "
+    "the half-edges of edge e are half_edges[offsets[e]:offsets[e+1]]; 'face_edges' (3M,) gives the edge of every "
+    "half-edge. 'non_manifold_edges' and 'boundary_edges' index the edges shared by more than two faces and by a "
+    "single face. Raises IndexError on out of range face indices");
+}
+
+void instrumentationSubmodule(py::module_ &_m)
+{
+    namespace instr = openstl::instrumentation;
+    auto m = _m.def_submodule("instrumentation", "Timers and counters of the reading, writing, conversion and "
+                                                 "topology stages, when built with OPENSTL_ENABLE_INSTRUMENTATION");
+
+    m.attr("enabled") = instr::ENABLED;
+
+    m.def("stats", []() {
+        const auto stats = instr::stats();
+        py::dict counters;
+        for (size_t i = 0; i < instr::COUNTER_COUNT; ++i)
+            counters[instr::counterName(static_cast<instr::Counter>(i))] = stats.counters[i];
+        py::dict timers;
+        for (const auto &timer : stats.timers) {
+            py::dict entry;
+            entry["calls"] = timer.calls;
+            entry["total_seconds"] = timer.total_seconds;
+            entry["max_seconds"] = timer.max_seconds;
+            timers[py::str(timer.name)] = entry;
+        }
+        py::dict result;
+        result["enabled"] = instr::ENABLED;
+        result["counters"] = counters;
+        result["timers"] = timers;
+        result["dropped_events"] = stats.dropped_events;
+        return result;
+    },
+    "Return the accumulated statistics as a dict: 'counters' maps bytes_read, bytes_written, triangles_parsed, "
+    "triangles_written, hash_probes, allocations and allocated_bytes to their values; 'timers' maps every timed "
+    "stage to its calls, total_seconds and max_seconds, nested stages being included in their parent. Everything "
+    "stays zero unless 'enabled' is True");
+
+    m.def("reset", &instr::reset, "Zero the counters and forget the timed stages");
+
+    m.def("chrome_trace", []() { return instr::chromeTrace(); },
+    "Return the timed stages as a Chrome trace JSON string, to load in chrome://tracing or Perfetto");
+
+    m.def("write_chrome_trace", [](const std::string &filename) {
+        std::ofstream file(filename, std::ios::binary);
+        if (!file.is_open())
+            throw std::runtime_error("Unable to open file '" + filename + "' for writing.");
+        instr::writeChromeTrace(file);
+    }, "filename"_a, "Write the Chrome trace of chrome_trace to a file");
 }
 
 PYBIND11_MODULE(openstl, m) {
     serialize(m);
+    normals(m);
+    transforms(m);
+    statistics(m);
     convertSubmodule(m);
     topologySubmodule(m);
+    instrumentationSubmodule(m);
     m.attr("__version__") = OPENSTL_PROJECT_VER;
     m.doc() = "A simple STL serializer and deserializer";
 
     PYBIND11_NUMPY_DTYPE(Vec3, x, y, z);
     PYBIND11_NUMPY_DTYPE(Triangle, normal, v0, v1, v2, attribute_byte_count);
+    m.attr("triangle_dtype") = py::dtype::of<Triangle>();
 }
\ No newline at end of file
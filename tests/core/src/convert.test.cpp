@@ -1,6 +1,8 @@
 #include <catch2/catch_test_macros.hpp>
 #include "openstl/core/stl.h"
 #include <unordered_set>
+#include <cstring>
+#include <list>
 #include <algorithm>
 
 using namespace openstl;
@@ -116,6 +118,172 @@ TEST_CASE("convertToVerticesAndFaces function test", "[convertToVerticesAndFaces
     }
 }
 
+TEST_CASE("Vertex welding engine", "[convertToVerticesAndFaces][VertexIndexMap]") {
+    SECTION("Permuted coordinates do not collide") {
+        REQUIRE(hashVec3({1.f, 2.f, 3.f}) != hashVec3({3.f, 2.f, 1.f}));
+        REQUIRE(hashVec3({1.f, 2.f, 3.f}) != hashVec3({2.f, 1.f, 3.f}));
+        REQUIRE(hashVec3({0.f, 0.f, 0.f}) == hashVec3({-0.f, 0.f, -0.f}));
+    }
+
+    SECTION("Vertices are numbered in order of first appearance") {
+        const Vec3 a{0.f, 0.f, 0.f}, b{1.f, 0.f, 0.f}, c{0.f, 1.f, 0.f}, d{1.f, 1.f, 0.f};
+        const std::vector<Triangle> triangles = {
+                {{0.f, 0.f, 1.f}, a, b, c, 0},
+                {{0.f, 0.f, 1.f}, c, b, d, 0},
+                {{0.f, 0.f, 1.f}, {-0.f, 0.f, 0.f}, d, c, 0}, // -0 welds with +0
+        };
+        const auto& [vertices, faces] = convertToVerticesAndFaces(triangles);
+        REQUIRE(vertices.size() == 4);
+        REQUIRE(vertices[0] == a);
+        REQUIRE(vertices[1] == b);
+        REQUIRE(vertices[2] == c);
+        REQUIRE(vertices[3] == d);
+        REQUIRE(faces == std::vector<Face>{{0, 1, 2}, {2, 1, 3}, {0, 3, 2}});
+    }
+
+    SECTION("Welding matches a reference map on a large mesh") {
+        // Vertices on a coarse lattice, so that many of them are shared
+        std::vector<Triangle> triangles(20000);
+        uint32_t state{12345u};
+        auto coordinate = [&state]() { state = state * 1664525u + 1013904223u; return static_cast<float>(state >> 28u); };
+        for (auto& tri : triangles) {
+            for (auto* v : {&tri.v0, &tri.v1, &tri.v2})
+                *v = {coordinate(), coordinate(), coordinate()};
+        }
+        const auto& [vertices, faces] = convertToVerticesAndFaces(triangles);
+        REQUIRE(vertices.size() == findInverseMap(triangles).size());
+        REQUIRE(faces.size() == triangles.size());
+        bool consistent{true};
+        for (size_t i = 0; i < triangles.size(); ++i) {
+            consistent &= vertices[faces[i][0]] == triangles[i].v0 && vertices[faces[i][1]] == triangles[i].v1
+                          && vertices[faces[i][2]] == triangles[i].v2;
+        }
+        REQUIRE(consistent);
+    }
+
+    SECTION("Parallel welding is identical to serial welding") {
+        std::vector<Triangle> triangles(50000);
+        uint32_t state{777u};
+        auto coordinate = [&state]() { state = state * 1664525u + 1013904223u; return static_cast<float>(state >> 27u); };
+        for (auto& tri : triangles) {
+            for (auto* v : {&tri.v0, &tri.v1, &tri.v2})
+                *v = {coordinate(), coordinate(), coordinate() * (state & 1u ? -0.f : 0.f)};
+        }
+        const auto& [vertices, faces] = convertToVerticesAndFaces(triangles);
+        for (const size_t numThreads : {2u, 3u, 8u, 0u}) {
+            WeldOptions options{};
+            options.num_threads = numThreads;
+            const auto& [parallelVertices, parallelFaces] = convertToVerticesAndFaces(triangles, options);
+            REQUIRE(parallelVertices == vertices);
+            REQUIRE(parallelFaces == faces);
+        }
+    }
+
+    SECTION("Morton order sorts vertices spatially") {
+        REQUIRE(mortonCode(1u, 0u, 0u) == 1u);
+        REQUIRE(mortonCode(0u, 1u, 0u) == 2u);
+        REQUIRE(mortonCode(0u, 0u, 1u) == 4u);
+        REQUIRE(mortonCode(0x1FFFFFu, 0x1FFFFFu, 0x1FFFFFu) == 0x7FFFFFFFFFFFFFFFull);
+
+        const Vec3 a{1.f, 1.f, 1.f}, b{0.f, 0.f, 0.f}, c{1.f, 0.f, 0.f}, d{0.f, 1.f, 0.f};
+        const std::vector<Triangle> triangles = {
+                {{0.f, 0.f, 1.f}, a, b, c, 0},
+                {{0.f, 0.f, 1.f}, d, c, b, 0},
+        };
+        WeldOptions options{};
+        options.vertex_order = VertexOrder::Morton;
+        const auto& [vertices, faces] = convertToVerticesAndFaces(triangles, options);
+        REQUIRE(vertices == std::vector<Vec3>{b, c, d, a});
+        REQUIRE(faces == std::vector<Face>{{3, 0, 1}, {2, 1, 0}});
+    }
+
+    SECTION("Morton order is independent of the number of threads") {
+        std::vector<Triangle> triangles(30000);
+        uint32_t state{99u};
+        auto coordinate = [&state]() { state = state * 1664525u + 1013904223u; return static_cast<float>(state >> 26u); };
+        for (auto& tri : triangles) {
+            for (auto* v : {&tri.v0, &tri.v1, &tri.v2})
+                *v = {coordinate(), coordinate(), coordinate()};
+        }
+        WeldOptions options{};
+        options.vertex_order = VertexOrder::Morton;
+        const auto& [vertices, faces] = convertToVerticesAndFaces(triangles, options);
+        options.num_threads = 4;
+        const auto& [parallelVertices, parallelFaces] = convertToVerticesAndFaces(triangles, options);
+        REQUIRE(parallelVertices == vertices);
+        REQUIRE(parallelFaces == faces);
+
+        bool consistent{true};
+        for (size_t i = 0; i < triangles.size(); ++i) {
+            consistent &= vertices[faces[i][0]] == triangles[i].v0 && vertices[faces[i][1]] == triangles[i].v1
+                          && vertices[faces[i][2]] == triangles[i].v2;
+        }
+        REQUIRE(consistent);
+    }
+}
+
+TEST_CASE("Tolerance-based vertex welding", "[convertToVerticesAndFaces][VertexGridMap]") {
+    SECTION("Near-duplicate vertices are welded to the first one") {
+        const Vec3 a{0.f, 0.f, 0.f}, b{1.f, 0.f, 0.f}, c{0.f, 1.f, 0.f};
+        const std::vector<Triangle> triangles = {
+                {{0.f, 0.f, 1.f}, a, b, c, 0},
+                {{0.f, 0.f, 1.f}, {0.999f, 0.0005f, 0.f}, {1.f, 1.f, 0.f}, {0.0004f, 1.0003f, -0.0002f}, 0},
+        };
+        REQUIRE(std::get<0>(convertToVerticesAndFaces(triangles)).size() == 6);
+
+        WeldOptions options{};
+        options.tolerance = 2e-3f;
+        const auto& [vertices, faces] = convertToVerticesAndFaces(triangles, options);
+        REQUIRE(vertices == std::vector<Vec3>{a, b, c, {1.f, 1.f, 0.f}});
+        REQUIRE(faces == std::vector<Face>{{0, 1, 2}, {1, 3, 2}});
+
+        options.tolerance = 0.f;
+        options.relative_tolerance = 1e-3f; // The bounding box diagonal is sqrt(2)
+        REQUIRE(std::get<1>(convertToVerticesAndFaces(triangles, options)) == faces);
+        options.relative_tolerance = 1e-4f;
+        REQUIRE(std::get<0>(convertToVerticesAndFaces(triangles, options)).size() == 6);
+    }
+
+    SECTION("Vertices across cell boundaries are welded") {
+        VertexGridMap map{0.1f};
+        REQUIRE(map.insert({0.099f, 0.f, 0.f}) == 0);
+        REQUIRE(map.insert({0.101f, 0.f, 0.f}) == 0);
+        REQUIRE(map.insert({-0.001f, 0.f, 0.f}) == 0);
+        REQUIRE(map.insert({-0.002f, 0.f, 0.f}) == 1); // Not within the tolerance of the first vertex
+        REQUIRE(map.insert({0.15f, 0.05f, -0.05f}) == 0);
+        REQUIRE(map.size() == 2);
+        REQUIRE_THROWS_AS(VertexGridMap{0.f}, std::invalid_argument);
+    }
+
+    SECTION("Welding a jittered grid matches the exact grid") {
+        // A lattice of spacing 1, each occurrence of a vertex being jittered by less than 0.01
+        std::vector<Triangle> exact, jittered;
+        uint32_t state{5u};
+        auto jitter = [&state]() { state = state * 1664525u + 1013904223u; return (static_cast<float>(state >> 8u) / 16777216.f - 0.5f) * 0.01f; };
+        for (int i = 0; i < 60; ++i) {
+            for (int j = 0; j < 60; ++j) {
+                const Vec3 p0{float(i), float(j), 0.f}, p1{float(i + 1), float(j), 0.f}, p2{float(i), float(j + 1), 0.f};
+                exact.push_back({{0.f, 0.f, 1.f}, p0, p1, p2, 0});
+                Triangle tri{{0.f, 0.f, 1.f}, p0, p1, p2, 0};
+                for (auto* v : {&tri.v0, &tri.v1, &tri.v2}) *v = {v->x + jitter(), v->y + jitter(), v->z + jitter()};
+                jittered.push_back(tri);
+            }
+        }
+        WeldOptions options{};
+        options.tolerance = 0.05f;
+        const auto& [vertices, faces] = convertToVerticesAndFaces(jittered, options);
+        const auto& [exactVertices, exactFaces] = convertToVerticesAndFaces(exact);
+        REQUIRE(vertices.size() == exactVertices.size());
+        REQUIRE(faces == exactFaces);
+    }
+
+    SECTION("Negative tolerances are rejected") {
+        WeldOptions options{};
+        options.tolerance = -1.f;
+        REQUIRE_THROWS_AS(convertToVerticesAndFaces(std::vector<Triangle>{}, options), std::invalid_argument);
+    }
+}
+
 TEST_CASE("convertToTriangles function test", "[convertToTriangles]") {
     SECTION("Face index out of range") {
         std::vector<Vec3> vertices = {
@@ -150,6 +318,72 @@ TEST_CASE("convertToTriangles function test", "[convertToTriangles]") {
     }
 }
 
+TEST_CASE("Compact face indices", "[convertToVerticesAndFaces][convertToTriangles]") {
+    std::vector<Triangle> triangles(20000);
+    uint32_t state{31u};
+    auto coordinate = [&state]() { state = state * 1664525u + 1013904223u; return static_cast<float>(state >> 27u); };
+    for (auto& tri : triangles) {
+        for (auto* v : {&tri.v0, &tri.v1, &tri.v2})
+            *v = {coordinate(), coordinate(), coordinate()};
+    }
+    const auto& [vertices, faces] = convertToVerticesAndFaces(triangles);
+
+    SECTION("32-bit faces hold the same indices") {
+        for (const size_t numThreads : {1u, 4u}) {
+            WeldOptions options{};
+            options.num_threads = numThreads;
+            options.vertex_order = numThreads == 1u ? VertexOrder::FirstAppearance : VertexOrder::Morton;
+            const auto& [compactVertices, compactFaces] = convertToVerticesAndFaces<uint32_t>(triangles, options);
+            static_assert(sizeof(compactFaces[0]) == 12, "Faces of 32-bit indices");
+            const auto& [wideVertices, wideFaces] = convertToVerticesAndFaces(triangles, options);
+            REQUIRE(compactVertices == wideVertices);
+            bool identical{compactFaces.size() == wideFaces.size()};
+            for (size_t i = 0; identical && i < wideFaces.size(); ++i) {
+                for (size_t corner = 0; corner < 3; ++corner) identical &= compactFaces[i][corner] == wideFaces[i][corner];
+            }
+            REQUIRE(identical);
+        }
+    }
+
+    SECTION("Too many vertices for the index type") {
+        REQUIRE_THROWS_AS(convertToVerticesAndFaces<uint8_t>(triangles), std::length_error);
+        WeldOptions options{};
+        options.num_threads = 4;
+        REQUIRE_THROWS_AS(convertToVerticesAndFaces<uint8_t>(triangles, options), std::length_error);
+        options.tolerance = 0.5f;
+        REQUIRE_THROWS_AS(convertToVerticesAndFaces<uint8_t>(triangles, options), std::length_error);
+        REQUIRE(std::get<1>(convertToVerticesAndFaces<uint8_t>(std::vector<Triangle>(triangles.begin(),
+                                                                                         triangles.begin() + 10)))
+                        .size() == 10);
+    }
+
+    SECTION("Triangles from faces of any integer type") {
+        std::vector<BasicFace<int32_t>> signedFaces;
+        for (const auto& face : faces)
+            signedFaces.push_back({static_cast<int32_t>(face[0]), static_cast<int32_t>(face[1]),
+                                   static_cast<int32_t>(face[2])});
+        const auto wide = convertToTriangles(vertices, faces);
+        const auto compact = convertToTriangles(vertices, signedFaces);
+        REQUIRE(std::memcmp(wide.data(), compact.data(), wide.size() * sizeof(Triangle)) == 0);
+
+        signedFaces.back()[1] = -1;
+        REQUIRE_THROWS_AS(convertToTriangles(vertices, signedFaces), std::out_of_range);
+        const std::list<BasicFace<uint32_t>> list = {{0, 1, 2}, {2, 1, static_cast<uint32_t>(vertices.size())}};
+        REQUIRE_THROWS_AS(convertToTriangles(vertices, list), std::out_of_range);
+    }
+
+    SECTION("Components with 32-bit faces") {
+        const auto components = findConnectedComponents<uint32_t>(vertices, faces);
+        const auto wide = findConnectedComponents(vertices, faces);
+        REQUIRE(components.size() == wide.size());
+        REQUIRE(components[0].size() == wide[0].size());
+        REQUIRE(components[0][0] == BasicFace<uint32_t>{static_cast<uint32_t>(wide[0][0][0]),
+                                                        static_cast<uint32_t>(wide[0][0][1]),
+                                                        static_cast<uint32_t>(wide[0][0][2])});
+        REQUIRE_THROWS_AS(findConnectedComponents<uint8_t>(vertices, faces), std::length_error);
+    }
+}
+
 template<typename T, size_t N>
 bool areAllUnique(const std::array<T, N>& arr) {
     std::unordered_set<T> seen;
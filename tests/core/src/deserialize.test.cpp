@@ -194,6 +194,72 @@ TEST_CASE("Deserialize ASCII STL: non-facet text is ignored (0 triangles)", "[op
     REQUIRE(tris.empty());
 }
 
+TEST_CASE("Deserialize ASCII STL: float tokenizer", "[openstl][ascii][float]") {
+    auto parse = [](const std::string& text, float& value) {
+        return parseFloat(text.data(), text.data() + text.size(), value);
+    };
+    float value{};
+    REQUIRE(parse("0.1", value) != nullptr);
+    REQUIRE(value == 0.1f);
+    REQUIRE(parse("-3.218319e-01", value) != nullptr);
+    REQUIRE(value == -3.218319e-01f);
+    REQUIRE(parse("+2E+00", value) != nullptr);
+    REQUIRE(value == 2.0f);
+    REQUIRE(parse(".5", value) != nullptr);
+    REQUIRE(value == 0.5f);
+    REQUIRE(parse("1e-07", value) != nullptr);
+    REQUIRE(value == 1e-07f);
+
+    const std::string trailing{"12.5abc"};
+    REQUIRE(parse(trailing, value) == trailing.data() + 4);
+    REQUIRE(value == 12.5f);
+
+    REQUIRE(parse("abc", value) == nullptr);
+    REQUIRE(parse("", value) == nullptr);
+    REQUIRE(parse("+-1", value) == nullptr);
+    REQUIRE(parse("1e60", value) == nullptr);
+}
+
+TEST_CASE("Deserialize ASCII STL: buffer and chunked stream readers agree", "[openstl][ascii][buffer]") {
+    std::string text{"solid s\n"};
+    for (int i = 0; i < 50; ++i) {
+        const auto k = std::to_string(i);
+        text += oneTriangleBlock("0 0 1", k + " 0 0", "0 " + k + " 0", "0 0 " + k);
+    }
+    text += "endsolid s"; // No trailing newline
+
+    std::stringstream ss(text);
+    const auto reference = deserializeAsciiStl(ss);
+    REQUIRE(reference.size() == 50);
+    REQUIRE(reference[49].v2.z == 49.0f);
+
+    const auto fromBuffer = deserializeAsciiStlBuffer(text.data(), text.size());
+    REQUIRE(testutils::checkTrianglesEqual(fromBuffer, reference));
+
+    // A tiny chunk forces partial lines across refills and buffer growth on long lines
+    std::stringstream chunked(text);
+    StreamLineReader<std::stringstream> lines{chunked, 8};
+    REQUIRE(testutils::checkTrianglesEqual(parseAsciiStl(lines, 50), reference));
+
+    REQUIRE_THROWS_AS(deserializeAsciiStlBuffer(text.data(), text.size(), 49), std::runtime_error);
+}
+
+TEST_CASE("Deserialize ASCII STL: errors report the offending line", "[openstl][ascii][error]") {
+    const std::string text =
+            "solid s\n"
+            "facet normal 0 0 1\n"
+            "outer loop\n"
+            "vertex 0 0 0\n"
+            "vertex 1 0\n"
+            "vertex 0 1 0\n";
+    try {
+        deserializeAsciiStlBuffer(text.data(), text.size());
+        FAIL("Expected a parsing error");
+    } catch (const std::runtime_error& e) {
+        REQUIRE(std::string(e.what()).find("line 5") != std::string::npos);
+    }
+}
+
 TEST_CASE("Deserialize Binary STL", "[openstl]") {
 
     SECTION("KEY")
@@ -277,47 +343,59 @@ TEST_CASE("Binary STL Serialization/Deserialization Security and Integrity Tests
         REQUIRE(file.is_open());
         CHECK_THROWS_AS(deserializeBinaryStl(file), std::runtime_error);
     }
-    SECTION("Test deserialization with the maximum number of triangles") {
-        const std::string filename = "max_triangles.stl";
-
-        // Create a file with exactly MAX_TRIANGLES triangles
-        std::vector<Triangle> triangles(MAX_TRIANGLES);
+    SECTION("Test deserialization beyond a million triangles with the default options") {
+        const std::string filename = "large_triangles.stl";
+        std::vector<Triangle> triangles(1000001);
         testutils::createStlWithTriangles(triangles, filename);
 
         std::ifstream file(filename, std::ios::binary);
         REQUIRE(file.is_open());
 
-        // Test that deserialization works correctly for MAX_TRIANGLES
         std::vector<Triangle> deserialized_triangles;
         CHECK_NOTHROW(deserialized_triangles = deserializeBinaryStl(file));
-        REQUIRE(deserialized_triangles.size() == MAX_TRIANGLES);
+        REQUIRE(deserialized_triangles.size() == triangles.size());
+        REQUIRE(deserialized_triangles.capacity() == triangles.size()); // Single exact allocation
     }
-    SECTION("Test deserialization exceeding the maximum number of triangles") {
-        const std::string filename = "exceeding_triangles.stl";
-
-        // Create a file with more than MAX_TRIANGLES triangles
-        std::vector<Triangle> triangles(MAX_TRIANGLES+1);
+    SECTION("Test deserialization with a maximum number of triangles") {
+        const std::string filename = "max_triangles.stl";
+        std::vector<Triangle> triangles(1000);
         testutils::createStlWithTriangles(triangles, filename);
 
+        ReadOptions options;
+        options.max_triangles = triangles.size();
         std::ifstream file(filename, std::ios::binary);
         REQUIRE(file.is_open());
+        REQUIRE(deserializeBinaryStl(file, options).size() == triangles.size());
 
-        // Test that deserialization throws an exception for exceeding MAX_TRIANGLES
-        CHECK_THROWS_AS(deserializeBinaryStl(file), std::runtime_error);
+        options.max_triangles = triangles.size() - 1;
+        file.seekg(0);
+        CHECK_THROWS_AS(deserializeBinaryStl(file, options), std::runtime_error);
     }
-    SECTION("Test deserialization exceeding the maximum number of triangles with deactivated safety") {
-        const std::string filename = "exceeding_triangles.stl";
-
-        // Create a file with more than MAX_TRIANGLES triangles
-        std::vector<Triangle> triangles(MAX_TRIANGLES+1);
+    SECTION("Test deserialization with a memory budget") {
+        const std::string filename = "memory_budget.stl";
+        std::vector<Triangle> triangles(1000);
         testutils::createStlWithTriangles(triangles, filename);
 
+        ReadOptions options;
+        options.memory_budget = triangles.size() * sizeof(Triangle);
         std::ifstream file(filename, std::ios::binary);
         REQUIRE(file.is_open());
+        REQUIRE(deserializeStl(file, options).size() == triangles.size());
 
-        // Deactivate buffer overflow safety
-        activateOverflowSafety() = false;
-        CHECK_NOTHROW(deserializeBinaryStl(file));
+        options.memory_budget -= 1;
+        file.seekg(0);
+        CHECK_THROWS_AS(deserializeStl(file, options), std::runtime_error);
+    }
+    SECTION("Test ASCII deserialization with the read options") {
+        std::stringstream ss;
+        serializeAsciiStl(testutils::createTestTriangle(), ss);
+        const auto count = deserializeStl(ss).size();
+
+        ReadOptions options;
+        options.max_triangles = count - 1;
+        ss.clear();
+        ss.seekg(0);
+        CHECK_THROWS_AS(deserializeStl(ss, options), std::runtime_error);
     }
     SECTION("Test deserialization with an empty file") {
         const std::string filename{"empty_triangles.stl"};
@@ -350,3 +428,195 @@ TEST_CASE("Binary STL Serialization/Deserialization Security and Integrity Tests
         testutils::checkTrianglesEqual(deserialized_triangles, triangles);
     }
 }
+
+TEST_CASE("Memory-mapped binary STL", "[openstl][mmap]") {
+    SECTION("Mapped triangles match the stream deserializer") {
+        for (const auto obj : {testutils::TESTOBJECT::KEY, testutils::TESTOBJECT::BALL, testutils::TESTOBJECT::WASHER}) {
+            const auto path = testutils::getTestObjectPath(obj);
+            std::ifstream file(path, std::ios::binary);
+            REQUIRE(file.is_open());
+            const auto triangles = deserializeBinaryStl(file);
+
+            const auto mapped = mapBinaryStl(path);
+            REQUIRE(mapped.size() == triangles.size());
+            REQUIRE(testutils::checkTrianglesEqual({mapped.begin(), mapped.end()}, triangles));
+        }
+    }
+    SECTION("Mapped triangles plug into serialize, convert and topology") {
+        const auto mapped = mapBinaryStl(testutils::getTestObjectPath(testutils::TESTOBJECT::KEY));
+
+        std::stringstream ss;
+        serialize(mapped, ss, StlFormat::Binary);
+        ss.seekg(0);
+        REQUIRE(testutils::checkTrianglesEqual(deserializeBinaryStl(ss), {mapped.begin(), mapped.end()}));
+
+        const auto& [vertices, faces] = convertToVerticesAndFaces(mapped);
+        REQUIRE(faces.size() == mapped.size());
+        REQUIRE(findConnectedComponents(vertices, faces).size() == 1);
+    }
+    SECTION("The view outlives its copies and checks bounds") {
+        MappedTriangles copy = mapBinaryStl(testutils::getTestObjectPath(testutils::TESTOBJECT::KEY));
+        {
+            const auto mapped = mapBinaryStl(testutils::getTestObjectPath(testutils::TESTOBJECT::KEY));
+            copy = mapped;
+        }
+        REQUIRE(copy.size() == 12);
+        REQUIRE_THAT(copy.at(0).normal.x, Catch::Matchers::WithinAbs(-1.0, 1e-6));
+        REQUIRE_THROWS_AS(copy.at(12), std::out_of_range);
+    }
+    SECTION("Corrupted files are rejected") {
+        const std::string incomplete{"mapped_incomplete_triangle_data.stl"};
+        testutils::createIncompleteTriangleData(testutils::createTestTriangle(), incomplete);
+        CHECK_THROWS_AS(mapBinaryStl(incomplete), std::runtime_error);
+
+        const std::string excessive{"mapped_excessive_triangle_count.stl"};
+        testutils::createExcessiveTriangleCount(testutils::createTestTriangle(), excessive);
+        CHECK_THROWS_AS(mapBinaryStl(excessive), std::runtime_error);
+
+        const std::string empty{"mapped_empty_triangles.stl"};
+        testutils::createEmptyStlFile(empty);
+        CHECK_THROWS_AS(mapBinaryStl(empty), std::runtime_error);
+
+        CHECK_THROWS_AS(mapBinaryStl("donotexist.stl"), std::runtime_error);
+    }
+    SECTION("The read options bound the mapped triangles") {
+        const auto path = testutils::getTestObjectPath(testutils::TESTOBJECT::KEY);
+        ReadOptions options;
+        options.max_triangles = 12;
+        REQUIRE(mapBinaryStl(path, options).size() == 12);
+
+        options.memory_budget = 11 * sizeof(Triangle);
+        CHECK_THROWS_AS(mapBinaryStl(path, options), std::runtime_error);
+    }
+}
+
+TEST_CASE("Deserialize ASCII STL in parallel", "[openstl][ascii][parallel]") {
+    // Large enough to be split in several chunks
+    const size_t count = 20000;
+    std::vector<std::string> facets(count);
+    for (size_t i = 0; i < count; ++i) {
+        const auto k = std::to_string(i);
+        facets[i] = oneTriangleBlock("0 0 1", k + " 0 0", "0 " + k + " 0", "0 0 " + k);
+    }
+    auto join = [](const std::vector<std::string>& blocks) {
+        std::string text{"solid s\n"};
+        for (const auto& block : blocks) text += block;
+        return text + "endsolid s\n";
+    };
+    auto errorOf = [](auto&& fn) -> std::string {
+        try {
+            fn();
+        } catch (const std::runtime_error& e) {
+            return e.what();
+        }
+        return {};
+    };
+
+    SECTION("Output is identical to the serial reader for any thread count") {
+        const std::string text = join(facets);
+        const auto reference = deserializeAsciiStlBuffer(text.data(), text.size());
+        REQUIRE(reference.size() == count);
+        for (size_t threads : {1u, 2u, 3u, 8u}) {
+            const auto parallel = deserializeAsciiStlBufferParallel(text.data(), text.size(),
+                                                                    std::numeric_limits<size_t>::max(), threads);
+            REQUIRE(testutils::checkTrianglesEqual(parallel, reference));
+        }
+        std::stringstream ss(text);
+        REQUIRE(testutils::checkTrianglesEqual(deserializeAsciiStlParallel(ss, count, 4), reference));
+    }
+    SECTION("The max_triangles limit is enforced") {
+        const std::string text = join(facets);
+        REQUIRE_THROWS_AS(deserializeAsciiStlBufferParallel(text.data(), text.size(), count - 1, 4), std::runtime_error);
+        REQUIRE(deserializeAsciiStlBufferParallel(text.data(), text.size(), count, 4).size() == count);
+    }
+    SECTION("Errors report the same offending line as the serial reader") {
+        auto broken = facets;
+        broken[count / 2] = oneTriangleBlock("0 0 1", "0 0 0", "1 0", "0 1 0");
+        broken[count - 10] = oneTriangleBlock("0 0 1", "0 0 0", "1 0 0", "zero 1 0");
+        const std::string text = join(broken);
+        const auto serialError = errorOf([&] { deserializeAsciiStlBuffer(text.data(), text.size()); });
+        REQUIRE(serialError.find("line " + std::to_string(2 + (count / 2) * 7 + 3)) != std::string::npos);
+        for (size_t threads : {2u, 8u}) {
+            REQUIRE(errorOf([&] {
+                deserializeAsciiStlBufferParallel(text.data(), text.size(), std::numeric_limits<size_t>::max(), threads);
+            }) == serialError);
+        }
+    }
+    SECTION("Facets swallowing the next facet line behave as in the serial reader") {
+        auto odd = facets;
+        for (size_t i = 0; i + 1 < count; i += 2) {
+            // A facet without 'outer loop': the next 'facet normal' line is consumed in its place.
+            // The padding makes chunk boundaries likely to fall on the swallowed line.
+            odd[i] = "facet normal 0 0 1 " + std::string(500, 'x') + "\n";
+            odd[i + 1] = "facet normal 0 1 0\nvertex 1 1 1\nvertex 2 2 2\nvertex 3 3 3\nendloop\nendfacet\n";
+        }
+        const std::string text = join(odd);
+        const auto reference = deserializeAsciiStlBuffer(text.data(), text.size());
+        for (size_t threads : {2u, 5u, 8u}) {
+            const auto parallel = deserializeAsciiStlBufferParallel(text.data(), text.size(),
+                                                                    std::numeric_limits<size_t>::max(), threads);
+            REQUIRE(testutils::checkTrianglesEqual(parallel, reference));
+        }
+    }
+}
+
+TEST_CASE("Deserialize STL in batches", "[openstl][streaming]") {
+    SECTION("Binary batches concatenate to the full mesh") {
+        std::ifstream file(testutils::getTestObjectPath(testutils::TESTOBJECT::BALL), std::ios::binary);
+        REQUIRE(file.is_open());
+        const auto reference = deserializeBinaryStl(file);
+        file.clear(); file.seekg(0);
+
+        StlBatchReader<std::ifstream> reader{file, 1000};
+        REQUIRE(reader.format() == StlFormat::Binary);
+        std::vector<Triangle> triangles;
+        while (reader.next()) {
+            REQUIRE(reader.batchCount() <= 1000);
+            triangles.insert(triangles.end(), reader.batchData(), reader.batchData() + reader.batchCount());
+        }
+        REQUIRE(reader.triangleCount() == 6162);
+        REQUIRE(testutils::checkTrianglesEqual(triangles, reference));
+    }
+    SECTION("ASCII batches concatenate to the full mesh") {
+        std::string text{"solid s\n"};
+        for (int i = 0; i < 25; ++i) {
+            const auto k = std::to_string(i);
+            text += oneTriangleBlock("0 0 1", k + " 0 0", "0 " + k + " 0", "0 0 " + k);
+        }
+        text += "endsolid s\n";
+        std::stringstream ss(text);
+        const auto reference = deserializeAsciiStl(ss);
+
+        std::stringstream stream(text);
+        std::vector<Triangle> triangles;
+        const auto count = forEachTriangleBatch(stream, [&](const Triangle* batch, size_t n) {
+            REQUIRE(n <= 10);
+            triangles.insert(triangles.end(), batch, batch + n);
+        }, 10);
+        REQUIRE(count == 25);
+        REQUIRE(testutils::checkTrianglesEqual(triangles, reference));
+    }
+    SECTION("Reductions run without materializing the mesh") {
+        std::ifstream file(testutils::getTestObjectPath(testutils::TESTOBJECT::WASHER), std::ios::binary);
+        REQUIRE(file.is_open());
+        float maxZ = std::numeric_limits<float>::lowest();
+        const auto count = forEachTriangleBatch(file, [&](const Triangle* batch, size_t n) {
+            for (size_t i = 0; i < n; ++i)
+                maxZ = std::max({maxZ, batch[i].v0.z, batch[i].v1.z, batch[i].v2.z});
+        }, 64);
+        REQUIRE(count == 424);
+
+        file.clear(); file.seekg(0);
+        float expected = std::numeric_limits<float>::lowest();
+        for (const auto& tri : deserializeBinaryStl(file))
+            expected = std::max({expected, tri.v0.z, tri.v1.z, tri.v2.z});
+        REQUIRE(maxZ == expected);
+    }
+    SECTION("Truncated binary files are rejected") {
+        const std::string filename{"batch_incomplete_triangle_data.stl"};
+        testutils::createIncompleteTriangleData(testutils::createTestTriangle(), filename);
+        std::ifstream file(filename, std::ios::binary);
+        REQUIRE(file.is_open());
+        CHECK_THROWS_AS(StlBatchReader<std::ifstream>(file), std::runtime_error);
+    }
+}
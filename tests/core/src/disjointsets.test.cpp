@@ -1,5 +1,8 @@
 #include <catch2/catch_test_macros.hpp>
 #include "openstl/core/stl.h"
+#include <list>
+#include <map>
+#include <utility>
 
 using namespace openstl;
 
@@ -89,4 +92,217 @@ TEST_CASE("Find connected components of faces", "[findConnectedComponents]") {
         REQUIRE(connectedComponents.size() == 1);
         REQUIRE(connectedComponents[0].size() == 3); // Only faces contribute
     }
-}
\ No newline at end of file
+}
+TEST_CASE("BasicDisjointSet with compact storage", "[DisjointSet]") {
+    SECTION("Roots are the smallest elements") {
+        BasicDisjointSet<uint32_t> ds(10);
+        ds.unite(7, 3);
+        ds.unite(9, 7);
+        REQUIRE(ds.find(9) == 3);
+        REQUIRE(ds.unite(3, 9) == false);
+        REQUIRE(ds.unite(8, 1) == true);
+        REQUIRE(ds.find(8) == 1);
+    }
+
+    SECTION("Long chains do not recurse") {
+        const uint32_t size = 2000000;
+        BasicDisjointSet<uint32_t> ds(size);
+        for (uint32_t i = size - 1; i > 0; --i) ds.unite(i, i - 1);
+        REQUIRE(ds.find(size - 1) == 0);
+        REQUIRE(ds.connected(size / 2, 1));
+    }
+
+    SECTION("The index type must represent every element") {
+        REQUIRE_NOTHROW(BasicDisjointSet<uint8_t>(256));
+        REQUIRE_THROWS_AS(BasicDisjointSet<uint8_t>(257), std::length_error);
+    }
+
+    SECTION("DisjointSet stores 32-bit parents, checked before allocating") {
+        STATIC_REQUIRE(std::is_same<DisjointSet, BasicDisjointSet<uint32_t>>::value);
+        if constexpr (sizeof(size_t) > sizeof(uint32_t)) {
+            // 16 GiB of parents if the size was checked after the allocation
+            REQUIRE_THROWS_AS(DisjointSet((size_t{1} << 32u) + 1u), std::length_error);
+        }
+    }
+
+    SECTION("Concurrent unions give the same sets as serial unions") {
+        const uint32_t size = 200000;
+        std::vector<std::pair<uint32_t, uint32_t>> pairs(150000);
+        uint32_t seed = 11u;
+        for (auto& pair : pairs) {
+            seed = seed * 1664525u + 1013904223u;
+            pair.first = (seed >> 8u) % size;
+            seed = seed * 1664525u + 1013904223u;
+            pair.second = (seed >> 8u) % size;
+        }
+        BasicDisjointSet<uint32_t> serial(size), concurrent(size);
+        for (const auto& pair : pairs) serial.unite(pair.first, pair.second);
+        parallelFor(pairs.size() / 1000, 4, [&](size_t block) {
+            for (size_t i = block * 1000; i < (block + 1) * 1000; ++i)
+                concurrent.uniteConcurrent(pairs[i].first, pairs[i].second);
+        });
+        bool identical{true};
+        for (uint32_t i = 0; i < size; ++i) identical &= serial.find(i) == concurrent.findConcurrent(i);
+        REQUIRE(identical);
+    }
+}
+
+TEST_CASE("Find connected components on several threads", "[findConnectedComponents]") {
+    // Strips of 3 triangles sharing vertices, each strip separate from the others
+    std::vector<std::array<float, 3>> vertices(5 * 100000);
+    std::vector<std::array<size_t, 3>> faces;
+    for (size_t strip = 0; strip < 100000; ++strip) {
+        const size_t v = 5 * strip;
+        faces.push_back({v, v + 1, v + 2});
+        faces.push_back({v + 2, v + 1, v + 3});
+        faces.push_back({v + 4, v + 2, v + 3});
+    }
+    const auto serial = findConnectedComponents(vertices, faces);
+    REQUIRE(serial.size() == 100000);
+    REQUIRE(findConnectedComponents(vertices, faces, 4) == serial);
+
+    faces.push_back({0, 1, vertices.size()});
+    REQUIRE_THROWS_AS(findConnectedComponents(vertices, faces), std::out_of_range);
+}
+
+TEST_CASE("Connected component labels", "[findConnectedComponents]") {
+    const std::vector<std::array<float, 3>> vertices(12);
+    const std::vector<std::array<size_t, 3>> faces = {
+        {5, 6, 7},   // Component 0
+        {0, 1, 2},   // Component 1
+        {8, 9, 10},  // Component 2
+        {2, 3, 4},   // Component 1, through vertex 2
+        {7, 11, 5},  // Component 0
+    };
+
+    SECTION("Labels in order of first appearance") {
+        const auto components = labelConnectedComponents(vertices, faces);
+        REQUIRE(components.component_count == 3);
+        REQUIRE(components.labels == std::vector<size_t>{0, 1, 2, 1, 0});
+    }
+
+    SECTION("Groups by counting sort") {
+        const auto groups = groupByComponent(labelConnectedComponents(vertices, faces));
+        REQUIRE(groups.offsets == std::vector<size_t>{0, 2, 4, 5});
+        REQUIRE(groups.face_order == std::vector<size_t>{0, 4, 1, 3, 2});
+    }
+
+    SECTION("Empty mesh") {
+        const auto components = labelConnectedComponents(vertices, std::vector<std::array<size_t, 3>>{});
+        REQUIRE(components.component_count == 0);
+        REQUIRE(groupByComponent(components).offsets == std::vector<size_t>{0});
+    }
+
+    SECTION("Threads and containers without operator[] agree") {
+        std::vector<std::array<float, 3>> stripVertices(5 * 50000);
+        std::vector<std::array<size_t, 3>> strips;
+        for (size_t strip = 0; strip < 50000; ++strip) {
+            const size_t v = 5 * ((strip * 7919) % 50000); // Strips numbered out of order
+            strips.push_back({v, v + 1, v + 2});
+            strips.push_back({v + 4, v + 2, v + 3});
+        }
+        const auto serial = labelConnectedComponents(stripVertices, strips);
+        REQUIRE(serial.component_count == 50000);
+        REQUIRE(labelConnectedComponents(stripVertices, strips, 4).labels == serial.labels);
+        const std::list<std::array<size_t, 3>> list(strips.begin(), strips.end());
+        REQUIRE(labelConnectedComponents(stripVertices, list).labels == serial.labels);
+    }
+}
+
+TEST_CASE("Edge adjacency", "[EdgeAdjacency]") {
+    SECTION("Half-edges grouped by sorted edge") {
+        const std::vector<std::array<float, 3>> vertices(4);
+        const std::vector<std::array<size_t, 3>> faces = {{0, 1, 2}, {2, 1, 3}};
+        const auto adjacency = buildEdgeAdjacency(vertices, faces);
+        REQUIRE(adjacency.faceCount() == 2);
+        REQUIRE(adjacency.edges == std::vector<std::array<uint32_t, 2>>{{0, 1}, {0, 2}, {1, 2}, {1, 3}, {2, 3}});
+        REQUIRE(adjacency.offsets == std::vector<uint32_t>{0, 1, 2, 4, 5, 6});
+        REQUIRE(adjacency.half_edges == std::vector<uint32_t>{0, 2, 1, 3, 4, 5});
+        REQUIRE(adjacency.face_edges == std::vector<uint32_t>{0, 2, 1, 2, 3, 4});
+
+        std::vector<std::pair<size_t, size_t>> neighbors;
+        adjacency.forEachNeighbor(0, [&](size_t face, size_t edge) { neighbors.emplace_back(face, edge); });
+        REQUIRE(neighbors == std::vector<std::pair<size_t, size_t>>{{1, 2}});
+        REQUIRE(findBoundaryEdges(adjacency) == std::vector<size_t>{0, 1, 3, 4});
+        REQUIRE(findNonManifoldEdges(adjacency).empty());
+    }
+
+    SECTION("Shells touching at a vertex are separate") {
+        // Two tetrahedra sharing vertex 3
+        const std::vector<std::array<float, 3>> vertices(7);
+        const std::vector<std::array<size_t, 3>> faces = {
+            {0, 2, 1}, {0, 1, 3}, {1, 2, 3}, {2, 0, 3},
+            {3, 5, 4}, {3, 4, 6}, {4, 5, 6}, {5, 3, 6},
+        };
+        REQUIRE(labelConnectedComponents(vertices, faces).component_count == 1);
+        const auto components = labelEdgeConnectedComponents(vertices, faces);
+        REQUIRE(components.component_count == 2);
+        REQUIRE(components.labels == std::vector<size_t>{0, 0, 0, 0, 1, 1, 1, 1});
+        REQUIRE(findEdgeConnectedComponents(vertices, faces).size() == 2);
+
+        const auto adjacency = buildEdgeAdjacency(vertices, faces);
+        REQUIRE(adjacency.edgeCount() == 12);
+        REQUIRE(findBoundaryEdges(adjacency).empty());
+        REQUIRE(findNonManifoldEdges(adjacency).empty());
+    }
+
+    SECTION("Non-manifold edges") {
+        const std::vector<std::array<float, 3>> vertices(5);
+        const std::vector<std::array<size_t, 3>> faces = {{0, 1, 2}, {1, 0, 3}, {0, 1, 4}};
+        const auto adjacency = buildEdgeAdjacency<size_t>(vertices, faces);
+        const auto nonManifold = findNonManifoldEdges(adjacency);
+        REQUIRE(nonManifold.size() == 1);
+        REQUIRE(adjacency.edges[nonManifold[0]] == std::array<size_t, 2>{0, 1});
+        REQUIRE(adjacency.edgeValence(nonManifold[0]) == 3);
+        REQUIRE(labelEdgeConnectedComponents(adjacency).component_count == 1);
+    }
+
+    SECTION("Matches a reference on several threads") {
+        const size_t vertexCount = 30000;
+        std::vector<std::array<float, 3>> vertices(vertexCount);
+        std::vector<std::array<size_t, 3>> faces(200000);
+        uint32_t seed = 5u;
+        for (auto& face : faces) {
+            for (auto& index : face) {
+                seed = seed * 1664525u + 1013904223u;
+                index = (seed >> 8u) % vertexCount;
+            }
+        }
+        std::map<std::pair<size_t, size_t>, std::vector<uint32_t>> reference;
+        for (size_t h = 0; h < 3 * faces.size(); ++h) {
+            const size_t a = faces[h / 3][h % 3], b = faces[h / 3][(h % 3 + 1) % 3];
+            reference[{std::min(a, b), std::max(a, b)}].push_back(static_cast<uint32_t>(h));
+        }
+
+        const auto adjacency = buildEdgeAdjacency(vertices, faces, 4);
+        REQUIRE(adjacency.edgeCount() == reference.size());
+        bool identical{true};
+        size_t e{0};
+        for (const auto& edge : reference) {
+            identical &= adjacency.edges[e][0] == edge.first.first && adjacency.edges[e][1] == edge.first.second;
+            identical &= std::vector<uint32_t>(adjacency.half_edges.begin() + adjacency.offsets[e],
+                                               adjacency.half_edges.begin() + adjacency.offsets[e + 1]) == edge.second;
+            for (const auto h : edge.second) identical &= adjacency.face_edges[h] == e;
+            ++e;
+        }
+        REQUIRE(identical);
+
+        const auto serial = buildEdgeAdjacency(vertices, faces);
+        REQUIRE(serial.half_edges == adjacency.half_edges);
+        REQUIRE(labelEdgeConnectedComponents(serial).labels == labelEdgeConnectedComponents(adjacency, 4).labels);
+        const std::list<std::array<size_t, 3>> list(faces.begin(), faces.end());
+        REQUIRE(buildEdgeAdjacency(vertices, list).face_edges == adjacency.face_edges);
+    }
+
+    SECTION("Invalid meshes") {
+        const std::vector<std::array<float, 3>> vertices(300);
+        REQUIRE_THROWS_AS(buildEdgeAdjacency(vertices, std::vector<std::array<size_t, 3>>{{0, 1, 300}}),
+                          std::out_of_range);
+        REQUIRE_THROWS_AS(buildEdgeAdjacency<uint8_t>(vertices, std::vector<std::array<size_t, 3>>{{0, 1, 2}}),
+                          std::length_error);
+        const auto empty = buildEdgeAdjacency(vertices, std::vector<std::array<size_t, 3>>{});
+        REQUIRE(empty.edgeCount() == 0);
+        REQUIRE(empty.offsets == std::vector<uint32_t>{0});
+        REQUIRE(labelEdgeConnectedComponents(empty).component_count == 0);
+    }
+}
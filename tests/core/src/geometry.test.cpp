@@ -0,0 +1,319 @@
+#include <catch2/catch_test_macros.hpp>
+#include "openstl/core/stl.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <sstream>
+
+using namespace openstl;
+
+namespace {
+    std::vector<Triangle> createRandomMesh(size_t count, uint32_t seed) {
+        std::vector<Triangle> triangles(count);
+        auto coordinate = [&seed]() { seed = seed * 1664525u + 1013904223u; return static_cast<float>(seed >> 8u) / 65536.f - 128.f; };
+        for (auto& tri : triangles) {
+            for (auto* v : {&tri.normal, &tri.v0, &tri.v1, &tri.v2}) *v = {coordinate(), coordinate(), coordinate()};
+            tri.attribute_byte_count = 7u;
+        }
+        return triangles;
+    }
+}
+
+TEST_CASE("Normal computation", "[normals]") {
+    SECTION("Unit normals follow the winding") {
+        auto triangles = createRandomMesh(1001, 1u); // Not a multiple of the block size
+        triangles[3].v2 = triangles[3].v1; // Degenerate
+        triangles[5].v0.x = std::numeric_limits<float>::quiet_NaN();
+        computeNormals(triangles);
+
+        bool consistent{true};
+        for (size_t i = 0; i < triangles.size(); ++i) {
+            const auto& tri = triangles[i];
+            if (i == 3 || i == 5) continue;
+            const double ax = double(tri.v1.x) - tri.v0.x, ay = double(tri.v1.y) - tri.v0.y, az = double(tri.v1.z) - tri.v0.z;
+            const double bx = double(tri.v2.x) - tri.v0.x, by = double(tri.v2.y) - tri.v0.y, bz = double(tri.v2.z) - tri.v0.z;
+            const double cx = ay * bz - az * by, cy = az * bx - ax * bz, cz = ax * by - ay * bx;
+            const double length = std::sqrt(cx * cx + cy * cy + cz * cz);
+            consistent &= std::abs(tri.normal.x - cx / length) < 1e-4 && std::abs(tri.normal.y - cy / length) < 1e-4
+                          && std::abs(tri.normal.z - cz / length) < 1e-4 && tri.attribute_byte_count == 7u;
+        }
+        REQUIRE(consistent);
+        REQUIRE(triangles[3].normal == Vec3{0.f, 0.f, 0.f});
+        REQUIRE(triangles[5].normal == Vec3{0.f, 0.f, 0.f});
+
+        const std::vector<Triangle> simple{{{5.f, 5.f, 5.f}, {0.f, 0.f, 0.f}, {2.f, 0.f, 0.f}, {0.f, 3.f, 0.f}, 0u}};
+        auto copy = simple;
+        computeNormals(copy);
+        REQUIRE(copy[0].normal == Vec3{0.f, 0.f, 1.f});
+    }
+
+    SECTION("Strided records give the same normals as packed triangles") {
+        auto triangles = createRandomMesh(300, 2u);
+        std::vector<float> array(triangles.size() * 12u); // (N,4,3) layout
+        for (size_t i = 0; i < triangles.size(); ++i) std::memcpy(&array[12 * i], &triangles[i], 12 * sizeof(float));
+        computeNormals(triangles);
+        computeNormals(array.data(), triangles.size(), 12 * sizeof(float));
+        bool identical{true};
+        for (size_t i = 0; i < triangles.size(); ++i) identical &= std::memcmp(&array[12 * i], &triangles[i], 48) == 0;
+        REQUIRE(identical);
+    }
+
+    SECTION("Inconsistent normals are reported") {
+        auto triangles = createRandomMesh(200, 3u);
+        computeNormals(triangles);
+        REQUIRE(findInconsistentNormals(triangles).empty());
+
+        triangles[10].normal = {-triangles[10].normal.x, -triangles[10].normal.y, -triangles[10].normal.z};
+        triangles[20].normal = {0.f, 0.f, 0.f};
+        triangles[30].normal = {triangles[30].normal.x * 4.f, triangles[30].normal.y * 4.f, triangles[30].normal.z * 4.f}; // Not unit, same direction
+        std::swap(triangles[40].v1, triangles[40].v2); // Flipped winding
+        triangles[50].v1 = triangles[50].v0; // Degenerate, never reported
+        REQUIRE(findInconsistentNormals(triangles) == std::vector<size_t>{10, 20, 40});
+        REQUIRE(findInconsistentNormals(triangles, 3.2f) == std::vector<size_t>{20});
+    }
+
+    SECTION("Read-only containers are rejected at compile time") {
+        STATIC_REQUIRE(detail::HasMutableContiguousTriangles<std::vector<Triangle>>::value);
+        STATIC_REQUIRE_FALSE(detail::HasMutableContiguousTriangles<const std::vector<Triangle>>::value);
+        STATIC_REQUIRE_FALSE(detail::HasMutableContiguousTriangles<MappedTriangles>::value); // PROT_READ mapping
+        STATIC_REQUIRE(detail::HasContiguousTriangles<MappedTriangles>::value);
+    }
+}
+
+TEST_CASE("Structure-of-arrays triangles", "[soa]") {
+    auto triangles = createRandomMesh(1003, 4u); // Not a multiple of the transpose group
+    for (auto& tri : triangles) tri.attribute_byte_count = 0u;
+
+    SECTION("Transposition round trips") {
+        const auto arrays = toTriangleArrays(triangles);
+        REQUIRE(arrays.size() == triangles.size());
+        REQUIRE(arrays.vertex(1, 2)[7] == triangles[7].v1.z);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(arrays.normal(0)) % 64u == 0u);
+        const auto back = toTriangles(arrays);
+        REQUIRE(std::memcmp(back.data(), triangles.data(), triangles.size() * sizeof(Triangle)) == 0);
+
+        std::vector<float> array(triangles.size() * 12u, -1.f); // (N,4,3) layout
+        arrays.toRecords(array.data(), 12 * sizeof(float));
+        bool identical{true};
+        for (size_t i = 0; i < triangles.size(); ++i) identical &= std::memcmp(&array[12 * i], &triangles[i], 48) == 0;
+        REQUIRE(identical);
+        const auto fromArray = TriangleArrays::fromRecords(array.data(), triangles.size(), 12 * sizeof(float));
+        REQUIRE(toTriangles(fromArray).back().v2 == triangles.back().v2);
+
+        const std::vector<Triangle> generic(arrays.begin(), arrays.end());
+        REQUIRE(std::memcmp(generic.data(), triangles.data(), triangles.size() * sizeof(Triangle)) == 0);
+    }
+
+    SECTION("Normals match the record kernel") {
+        triangles[3].v2 = triangles[3].v1; // Degenerate
+        auto arrays = toTriangleArrays(triangles);
+        computeNormals(arrays);
+        computeNormals(triangles);
+        REQUIRE(std::memcmp(toTriangles(arrays).data(), triangles.data(), triangles.size() * sizeof(Triangle)) == 0);
+    }
+
+    SECTION("Bounding box") {
+        triangles[11].v1.y = 500.f;
+        triangles[12].v2.x = -500.f;
+        triangles[13].v0.z = std::numeric_limits<float>::quiet_NaN(); // Ignored
+        const auto arrays = toTriangleArrays(triangles);
+        const auto box = computeBoundingBox(triangles);
+        const auto soaBox = computeBoundingBox(arrays);
+        REQUIRE(box.upper.y == 500.f);
+        REQUIRE(box.lower.x == -500.f);
+        REQUIRE(std::isfinite(box.lower.z));
+        REQUIRE(soaBox.lower == box.lower);
+        REQUIRE(soaBox.upper == box.upper);
+        REQUIRE(computeBoundingBox(TriangleArrays{}).empty());
+        REQUIRE_FALSE(box.empty());
+    }
+
+    SECTION("Welding matches packed triangles") {
+        triangles.resize(5000);
+        for (size_t i = 1; i < triangles.size(); ++i) triangles[i].v0 = triangles[i - 1].v2; // Shared vertices
+        const auto arrays = toTriangleArrays(triangles);
+        for (size_t numThreads : {1u, 4u}) {
+            WeldOptions options{};
+            options.num_threads = numThreads;
+            REQUIRE(convertToVerticesAndFaces(arrays, options) == convertToVerticesAndFaces(triangles, options));
+        }
+        WeldOptions options{};
+        options.relative_tolerance = 1e-3f;
+        REQUIRE(convertToVerticesAndFaces(arrays, options) == convertToVerticesAndFaces(triangles, options));
+    }
+}
+
+TEST_CASE("Affine transforms", "[transform]") {
+    // Non-uniform scaling, rotation of 30 degrees around z, then translation
+    const float c = std::cos(0.5235988f), s = std::sin(0.5235988f);
+    const AffineMatrix matrix{2.f * c, -3.f * s, 0.f, 1.f,
+                              2.f * s, 3.f * c, 0.f, -2.f,
+                              0.f, 0.f, 0.5f, 3.f};
+    auto apply = [&matrix](const Vec3& v) {
+        return Vec3{matrix[0] * v.x + matrix[1] * v.y + matrix[2] * v.z + matrix[3],
+                    matrix[4] * v.x + matrix[5] * v.y + matrix[6] * v.z + matrix[7],
+                    matrix[8] * v.x + matrix[9] * v.y + matrix[10] * v.z + matrix[11]};
+    };
+    auto near = [](const Vec3& a, const Vec3& b) {
+        return std::abs(a.x - b.x) < 1e-3f && std::abs(a.y - b.y) < 1e-3f && std::abs(a.z - b.z) < 1e-3f;
+    };
+    auto triangles = createRandomMesh(1003, 5u);
+    triangles[8].v1 = triangles[8].v0; // Degenerate
+    computeNormals(triangles);
+    triangles[9].normal = {0.f, 0.f, 0.f};
+
+    SECTION("Triangles: vertices by the matrix, normals by the inverse-transpose") {
+        auto transformed = triangles;
+        transformTriangles(transformed, matrix);
+        bool consistent{true};
+        for (size_t i = 0; i < triangles.size(); ++i) {
+            consistent &= near(transformed[i].v0, apply(triangles[i].v0)) && near(transformed[i].v1, apply(triangles[i].v1))
+                          && near(transformed[i].v2, apply(triangles[i].v2))
+                          && transformed[i].attribute_byte_count == triangles[i].attribute_byte_count;
+        }
+        REQUIRE(consistent);
+        REQUIRE(transformed[9].normal == Vec3{0.f, 0.f, 0.f});
+        // Normals stay perpendicular to the transformed faces; only the zero normal is reported
+        REQUIRE(findInconsistentNormals(transformed, 1e-3f) == std::vector<size_t>{9});
+    }
+
+    SECTION("Threads, strided records and TriangleArrays agree") {
+        auto serial = createRandomMesh(100003, 6u);
+        auto threaded = serial;
+        auto arrays = toTriangleArrays(serial);
+        std::vector<float> array(serial.size() * 12u); // (N,4,3) layout
+        for (size_t i = 0; i < serial.size(); ++i) std::memcpy(&array[12 * i], &serial[i], 48);
+
+        transformTriangles(serial, matrix);
+        transformTriangles(threaded, matrix, 4);
+        transformTriangles(arrays, matrix, 3);
+        transformTriangles(array.data(), serial.size(), 12 * sizeof(float), matrix, 2);
+        REQUIRE(std::memcmp(serial.data(), threaded.data(), serial.size() * sizeof(Triangle)) == 0);
+        const auto fromArrays = toTriangles(arrays);
+        bool identical{true};
+        for (size_t i = 0; i < serial.size(); ++i) {
+            identical &= std::memcmp(&array[12 * i], &serial[i], 48) == 0
+                         && std::memcmp(&fromArrays[i], &serial[i], 48) == 0;
+        }
+        REQUIRE(identical);
+    }
+
+    SECTION("Vertices") {
+        std::vector<Vec3> vertices(70001);
+        for (size_t i = 0; i < vertices.size(); ++i) vertices[i] = triangles[i % triangles.size()].v1;
+        auto serial = vertices, threaded = vertices;
+        transformVertices(serial, matrix);
+        transformVertices(threaded, matrix, 4);
+        REQUIRE(std::memcmp(serial.data(), threaded.data(), serial.size() * sizeof(Vec3)) == 0);
+        bool consistent{true};
+        for (size_t i = 0; i < vertices.size(); ++i) consistent &= near(serial[i], apply(vertices[i]));
+        REQUIRE(consistent);
+
+        std::vector<float> padded(vertices.size() * 4u, 7.f); // (N,4) rows, the last column untouched
+        for (size_t i = 0; i < vertices.size(); ++i) std::memcpy(&padded[4 * i], &vertices[i], sizeof(Vec3));
+        transformVertices(padded.data(), vertices.size(), 4 * sizeof(float), matrix, 2);
+        bool padding{true};
+        for (size_t i = 0; i < vertices.size(); ++i)
+            padding &= padded[4 * i + 3] == 7.f && std::memcmp(&padded[4 * i], &serial[i], sizeof(Vec3)) == 0;
+        REQUIRE(padding);
+    }
+
+    SECTION("Mirroring and singular matrices") {
+        const AffineMatrix mirror{-1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f};
+        std::vector<Triangle> tri{{{1.f, 0.f, 0.f}, {0.f, 0.f, 0.f}, {0.f, 1.f, 0.f}, {0.f, 0.f, 1.f}, 0u}};
+        transformTriangles(tri, mirror);
+        REQUIRE(tri[0].normal == Vec3{-1.f, 0.f, 0.f});
+        const AffineMatrix flatten{1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f};
+        std::vector<Triangle> slanted{{{0.f, 0.6f, 0.8f}, {0.f, 0.f, 0.f}, {1.f, 0.f, 0.f}, {0.f, 1.f, 0.f}, 0u}};
+        transformTriangles(slanted, flatten);
+        REQUIRE(slanted[0].normal == Vec3{0.f, 0.f, 1.f});
+    }
+
+    SECTION("Read-only containers are rejected at compile time") {
+        const auto constant = triangles;
+        // transformTriangles(constant, matrix) and transformTriangles(mapBinaryStl(...), matrix) fail to compile
+        STATIC_REQUIRE_FALSE(detail::HasMutableContiguousTriangles<decltype(constant)>::value);
+        STATIC_REQUIRE_FALSE(detail::HasMutableContiguousTriangles<MappedTriangles>::value);
+    }
+}
+
+TEST_CASE("Mesh statistics", "[stats]") {
+    const std::vector<Vec3> cubeVertices{{0.f, 0.f, 0.f}, {1.f, 0.f, 0.f}, {1.f, 1.f, 0.f}, {0.f, 1.f, 0.f},
+                                         {0.f, 0.f, 1.f}, {1.f, 0.f, 1.f}, {1.f, 1.f, 1.f}, {0.f, 1.f, 1.f}};
+    const std::vector<Face> cubeFaces{{0, 2, 1}, {0, 3, 2}, {4, 5, 6}, {4, 6, 7}, {0, 1, 5}, {0, 5, 4},
+                                      {3, 7, 6}, {3, 6, 2}, {0, 4, 7}, {0, 7, 3}, {1, 2, 6}, {1, 6, 5}};
+
+    SECTION("Closed cube") {
+        auto cube = convertToTriangles(cubeVertices, cubeFaces);
+        cube.push_back({{0.f, 0.f, 0.f}, {5.f, 5.f, 5.f}, {5.f, 5.f, 5.f}, {5.f, 5.f, 5.f}, 0u}); // Degenerate
+        const auto stats = computeMeshStats(cube);
+        REQUIRE(stats.triangle_count == 13);
+        REQUIRE(stats.degenerate_count == 1);
+        REQUIRE(stats.area == 6.0);
+        REQUIRE(stats.signed_volume == 1.0);
+        REQUIRE(stats.centroid == Vec3{0.5f, 0.5f, 0.5f});
+        REQUIRE(stats.bounds.lower == Vec3{0.f, 0.f, 0.f});
+        REQUIRE(stats.bounds.upper == Vec3{5.f, 5.f, 5.f});
+
+        const auto indexed = computeIndexedMeshStats(cubeVertices, cubeFaces);
+        REQUIRE(indexed.area == 6.0);
+        REQUIRE(indexed.signed_volume == 1.0);
+        REQUIRE(indexed.bounds.upper == Vec3{1.f, 1.f, 1.f});
+        REQUIRE_THROWS_AS(computeIndexedMeshStats(cubeVertices, std::vector<Face>{{0, 1, 8}}), std::out_of_range);
+
+        std::reverse(cube.begin(), cube.end()); // Flipping the winding flips the volume
+        for (auto& tri : cube) std::swap(tri.v1, tri.v2);
+        REQUIRE(computeMeshStats(cube).signed_volume == -1.0);
+    }
+
+    SECTION("Random mesh against a double precision reference") {
+        auto triangles = createRandomMesh(100003, 7u);
+        triangles[17].v2 = triangles[17].v0; // Degenerate
+        triangles[18].v1.x = std::numeric_limits<float>::quiet_NaN();
+        double area{0.0}, volume{0.0}, cx{0.0};
+        for (size_t i = 0; i < triangles.size(); ++i) {
+            if (i == 17 || i == 18) continue;
+            const auto& t = triangles[i];
+            const double ax = double(t.v1.x) - t.v0.x, ay = double(t.v1.y) - t.v0.y, az = double(t.v1.z) - t.v0.z;
+            const double bx = double(t.v2.x) - t.v0.x, by = double(t.v2.y) - t.v0.y, bz = double(t.v2.z) - t.v0.z;
+            const double nx = ay * bz - az * by, ny = az * bx - ax * bz, nz = ax * by - ay * bx;
+            const double length = std::sqrt(nx * nx + ny * ny + nz * nz);
+            area += length / 2.0;
+            volume += (t.v0.x * nx + t.v0.y * ny + t.v0.z * nz) / 6.0;
+            cx += length / 2.0 * (double(t.v0.x) + t.v1.x + t.v2.x) / 3.0;
+        }
+        const auto stats = computeMeshStats(triangles);
+        REQUIRE(stats.triangle_count == triangles.size());
+        REQUIRE(stats.degenerate_count == 2);
+        REQUIRE(std::abs(stats.area - area) < 1e-5 * area);
+        REQUIRE(std::abs(stats.signed_volume - volume) < 1e-4 * std::abs(volume) + 1.0);
+        REQUIRE(std::abs(stats.centroid.x - cx / area) < 1e-3);
+        REQUIRE(stats.bounds.lower == computeBoundingBox(triangles).lower);
+        REQUIRE(stats.bounds.upper == computeBoundingBox(triangles).upper);
+
+        // Identical for any number of threads and through the generic container path
+        const auto threaded = computeMeshStats(triangles, 4);
+        REQUIRE(threaded.area == stats.area);
+        REQUIRE(threaded.signed_volume == stats.signed_volume);
+        REQUIRE(threaded.centroid == stats.centroid);
+        const auto generic = computeMeshStats(toTriangleArrays(triangles));
+        REQUIRE(std::abs(generic.area - area) < 1e-5 * area);
+        REQUIRE(generic.degenerate_count == 2);
+    }
+
+    SECTION("Streaming through batches") {
+        const auto triangles = createRandomMesh(20000, 8u);
+        std::stringstream stream;
+        serializeBinaryStl(triangles, stream);
+        MeshStatsAccumulator accumulator;
+        forEachTriangleBatch(stream, [&accumulator](const Triangle* batch, size_t count) {
+            accumulator.add(batch, count, sizeof(Triangle));
+        }, 3000);
+        const auto streamed = accumulator.stats();
+        const auto whole = computeMeshStats(triangles);
+        REQUIRE(streamed.triangle_count == whole.triangle_count);
+        REQUIRE(std::abs(streamed.area - whole.area) < 1e-9 * whole.area);
+        REQUIRE(streamed.bounds.lower == whole.bounds.lower);
+    }
+}
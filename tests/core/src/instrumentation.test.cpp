@@ -0,0 +1,110 @@
+#include <catch2/catch_test_macros.hpp>
+#include "openstl/core/stl.h"
+#include <algorithm>
+#include <sstream>
+
+using namespace openstl;
+
+namespace {
+    std::vector<Triangle> createStrip(size_t count) {
+        std::vector<Triangle> triangles(count);
+        for (size_t i = 0; i < count; ++i) {
+            const auto x = static_cast<float>(i);
+            triangles[i] = Triangle{{0.f, 0.f, 1.f}, {x, 0.f, 0.f}, {x + 1.f, 0.f, 0.f}, {x, 1.f, 0.f}, 0u};
+        }
+        return triangles;
+    }
+
+    const instrumentation::TimerStats* findTimer(const instrumentation::Stats& stats, const std::string& name) {
+        const auto timer = std::find_if(stats.timers.begin(), stats.timers.end(),
+                                        [&name](const instrumentation::TimerStats& t) { return t.name == name; });
+        return timer != stats.timers.end() ? &*timer : nullptr;
+    }
+}
+
+TEST_CASE("Instrumentation", "[instrumentation]") {
+    instrumentation::reset();
+    const auto triangles = createStrip(1000);
+    std::stringstream stream;
+    serializeBinaryStl(triangles, stream);
+    const auto read = deserializeBinaryStl(stream);
+    REQUIRE(read.size() == triangles.size());
+    const auto mesh = convertToVerticesAndFaces(read);
+    REQUIRE(std::get<1>(mesh).size() == triangles.size());
+    const auto stats = instrumentation::stats();
+    const std::string trace = instrumentation::chromeTrace();
+
+    if constexpr (!instrumentation::ENABLED) {
+        SECTION("Nothing is recorded when disabled") {
+            for (const auto value : stats.counters) CHECK(value == 0u);
+            CHECK(stats.timers.empty());
+            CHECK(trace.find("\"ph\":\"X\"") == std::string::npos);
+            CHECK(trace.find("\"triangles_parsed\":0") != std::string::npos);
+        }
+    } else {
+        SECTION("Counters") {
+            const uint64_t bytes = BINARY_STL_HEADER_SIZE + triangles.size() * sizeof(Triangle);
+            CHECK(stats.counter(instrumentation::Counter::BytesWritten) == bytes);
+            CHECK(stats.counter(instrumentation::Counter::TrianglesWritten) == triangles.size());
+            CHECK(stats.counter(instrumentation::Counter::BytesRead) == bytes);
+            CHECK(stats.counter(instrumentation::Counter::TrianglesParsed) == triangles.size());
+            // Every vertex reference probes at least one slot
+            CHECK(stats.counter(instrumentation::Counter::HashProbes) >= 3u * triangles.size());
+            CHECK(stats.counter(instrumentation::Counter::Allocations) >= 2u);
+            CHECK(stats.counter(instrumentation::Counter::AllocatedBytes) >= triangles.size() * sizeof(Triangle));
+        }
+
+        SECTION("Timers") {
+            for (const char* name : {"serializeBinaryStl", "deserializeBinaryStl", "convertToVerticesAndFaces",
+                                     "weldVertices"}) {
+                const auto* timer = findTimer(stats, name);
+                REQUIRE(timer != nullptr);
+                CHECK(timer->calls == 1u);
+                CHECK(timer->total_seconds >= 0.0);
+                CHECK(timer->max_seconds == timer->total_seconds);
+            }
+            // Nested scopes are included in their parent
+            CHECK(findTimer(stats, "weldVertices")->total_seconds
+                  <= findTimer(stats, "convertToVerticesAndFaces")->total_seconds);
+        }
+
+        SECTION("Chrome trace") {
+            CHECK(trace.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0) == 0u);
+            CHECK(trace.find("{\"name\":\"deserializeBinaryStl\",\"cat\":\"openstl\",\"ph\":\"X\"") != std::string::npos);
+            CHECK(trace.find("\"triangles_parsed\":1000") != std::string::npos);
+            CHECK(trace.find("},\n]") == std::string::npos); // No trailing comma
+        }
+
+        SECTION("Scopes from several threads are aggregated") {
+            instrumentation::reset();
+            WeldOptions options;
+            options.num_threads = 4;
+            const auto parallel = convertToVerticesAndFaces(createStrip(10000), options);
+            const auto multithreaded = instrumentation::stats();
+            REQUIRE(std::get<1>(parallel).size() == 10000u);
+            REQUIRE(findTimer(multithreaded, "convertToVerticesAndFacesParallel") != nullptr);
+            CHECK(multithreaded.counter(instrumentation::Counter::HashProbes) >= 30000u);
+        }
+
+        SECTION("Reset") {
+            instrumentation::reset();
+            const auto cleared = instrumentation::stats();
+            for (const auto value : cleared.counters) CHECK(value == 0u);
+            CHECK(cleared.timers.empty());
+            CHECK(cleared.dropped_events == 0u);
+        }
+    }
+
+    SECTION("Local counters are flushed once, copies start from zero") {
+        instrumentation::reset();
+        {
+            instrumentation::LocalCounter probes{instrumentation::Counter::HashProbes};
+            ++probes;
+            ++probes;
+            instrumentation::LocalCounter copy{probes};
+            ++copy;
+        }
+        CHECK(instrumentation::stats().counter(instrumentation::Counter::HashProbes)
+              == (instrumentation::ENABLED ? 3u : 0u));
+    }
+}
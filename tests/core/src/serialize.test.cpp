@@ -1,9 +1,31 @@
 #include <catch2/catch_test_macros.hpp>
 #include "openstl/tests/testutils.h"
 #include "openstl/core/stl.h"
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <list>
 
 using namespace openstl;
 
+namespace {
+    // A view over rows of 12 floats, as the Python bindings' span over (N,4,3) arrays
+    struct FloatRows {
+        static constexpr size_t STRIDE_BYTES = 12 * sizeof(float);
+
+        struct Iterator {
+            const float* ptr;
+            const Triangle& operator*() const { return *reinterpret_cast<const Triangle*>(ptr); }
+            Iterator& operator++() { ptr += 12; return *this; }
+            bool operator!=(const Iterator& other) const { return ptr != other.ptr; }
+        };
+
+        const std::vector<float>& rows;
+        Iterator begin() const { return {rows.data()}; }
+        Iterator end() const { return {rows.data() + rows.size()}; }
+        size_t size() const { return rows.size() / 12; }
+    };
+}
 
 TEST_CASE("Serialize STL triangles", "[openstl]") {
     // Generate some sample triangles
@@ -71,4 +93,130 @@ TEST_CASE("Serialize STL triangles", "[openstl]") {
         // Validate deserialized triangles against original triangles
         REQUIRE(testutils::checkTrianglesEqual(deserializedTriangles, originalTriangles, true));
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Buffered ASCII STL writer", "[openstl][ascii]") {
+    SECTION("Facets are formatted in the STL layout") {
+        const std::vector<Triangle> triangles{
+                {{0.0f, 0.0f, 1.0f}, {0.1f, -2.5f, 1e-7f}, {1.0f, 1e20f, 0.0f}, {-0.0f, 3.0f, 123456.79f}, 0u}
+        };
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L // Without it, 9 digits are always written
+        std::stringstream ss;
+        serializeAsciiStl(triangles, ss);
+        REQUIRE(ss.str() == "solid\n"
+                            "facet normal 0 0 1\n"
+                            "outer loop\n"
+                            "vertex 0.1 -2.5 1e-07\n"
+                            "vertex 1 1e+20 0\n"
+                            "vertex -0 3 123456.79\n"
+                            "endloop\n"
+                            "endfacet\n"
+                            "endsolid\n");
+#endif
+
+        std::stringstream rounded;
+        serializeAsciiStl(triangles, rounded, 3);
+        REQUIRE(rounded.str().find("vertex -0 3 1.23e+05\n") != std::string::npos);
+    }
+
+    SECTION("Shortest formatting round-trips exactly across buffer flushes") {
+        // Arbitrary finite bit patterns, covering every exponent
+        std::vector<Triangle> triangles(5000);
+        uint32_t state{2024u};
+        auto randomFloat = [&state]() {
+            float value;
+            do {
+                state = state * 1664525u + 1013904223u;
+                const uint32_t bits = state ^ (state >> 15u);
+                std::memcpy(&value, &bits, sizeof(value));
+            } while (!std::isfinite(value));
+            return value;
+        };
+        for (auto& tri : triangles) {
+            for (auto* v : {&tri.normal, &tri.v0, &tri.v1, &tri.v2}) *v = {randomFloat(), randomFloat(), randomFloat()};
+            tri.attribute_byte_count = 0u;
+        }
+        triangles.front().v0 = {std::numeric_limits<float>::max(), std::numeric_limits<float>::denorm_min(),
+                                -std::numeric_limits<float>::min()};
+        for (const std::size_t bufferSize : {std::size_t{1}, std::size_t{4096}, std::size_t{1} << 20u}) {
+            std::stringstream ss;
+            serializeAsciiStl(triangles, ss, SHORTEST_PRECISION, bufferSize);
+            ss.seekg(0);
+            const auto deserialized = deserializeAsciiStl(ss);
+            REQUIRE(deserialized.size() == triangles.size());
+            bool identical{true};
+            for (size_t i = 0; i < triangles.size(); ++i) {
+                identical &= std::memcmp(&deserialized[i], &triangles[i], 48) == 0;
+            }
+            REQUIRE(identical);
+        }
+    }
+}
+
+TEST_CASE("Parallel ASCII STL writer", "[openstl][ascii]") {
+    std::vector<Triangle> triangles(30000);
+    uint32_t state{7u};
+    auto coordinate = [&state]() { state = state * 1664525u + 1013904223u; return static_cast<float>(static_cast<int32_t>(state)) * 1e-6f; };
+    for (auto& tri : triangles) {
+        for (auto* v : {&tri.normal, &tri.v0, &tri.v1, &tri.v2}) *v = {coordinate(), coordinate(), coordinate()};
+    }
+
+    for (const size_t count : {size_t{0}, size_t{100}, size_t{4097}, triangles.size()}) {
+        const std::vector<Triangle> subset(triangles.begin(), triangles.begin() + count);
+        std::stringstream serial;
+        serializeAsciiStl(subset, serial, 5);
+        for (const size_t numThreads : {1u, 2u, 3u, 8u}) {
+            std::stringstream parallel;
+            serializeAsciiStlParallel(subset, parallel, numThreads, 5);
+            REQUIRE(parallel.str() == serial.str());
+        }
+    }
+}
+
+TEST_CASE("Binary STL writers", "[openstl][binary]") {
+    std::vector<Triangle> triangles(3 * BINARY_STAGING_TRIANGLES / 2);
+    for (size_t i = 0; i < triangles.size(); ++i) {
+        const auto f = static_cast<float>(i);
+        triangles[i] = {{f, 0.f, 1.f}, {f, f, f}, {f + 1.f, f, f}, {f, f + 1.f, f}, static_cast<uint16_t>(i)};
+    }
+    std::stringstream reference;
+    serializeBinaryStl(triangles, reference);
+    REQUIRE(reference.str().size() == BINARY_STL_HEADER_SIZE + triangles.size() * sizeof(Triangle));
+
+    SECTION("Staged and contiguous writes are identical") {
+        const std::list<Triangle> list(triangles.begin(), triangles.end()); // No contiguous storage
+        std::stringstream staged;
+        serializeBinaryStl(list, staged);
+        REQUIRE(staged.str() == reference.str());
+    }
+
+    SECTION("Rows without attribute are written with a zero attribute byte count") {
+        std::vector<float> rows(12 * triangles.size()); // Sized exactly, so that overreads are caught by ASan
+        std::vector<Triangle> expected{triangles};
+        for (size_t i = 0; i < triangles.size(); ++i) {
+            std::memcpy(&rows[12 * i], &triangles[i], 12 * sizeof(float));
+            expected[i].attribute_byte_count = 0u;
+        }
+        std::stringstream staged, contiguous;
+        serializeBinaryStl(FloatRows{rows}, staged);
+        serializeBinaryStl(expected, contiguous);
+        REQUIRE(staged.str() == contiguous.str());
+    }
+
+    SECTION("Raw file writer") {
+        const std::string filename{"test_raw_binary.stl"};
+        for (const bool contiguous : {true, false}) {
+            if (contiguous) writeBinaryStlFile(filename, triangles);
+            else writeBinaryStlFile(filename, std::list<Triangle>(triangles.begin(), triangles.end()));
+            std::ifstream file(filename, std::ios::binary);
+            const std::string content{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+            REQUIRE(content == reference.str());
+        }
+        writeBinaryStlFile(filename, std::vector<Triangle>{});
+        std::ifstream file(filename, std::ios::binary);
+        REQUIRE(deserializeBinaryStl(file).empty());
+        file.close();
+        std::remove(filename.c_str());
+        REQUIRE_THROWS_AS(writeBinaryStlFile("missing_directory/test.stl", triangles), std::runtime_error);
+    }
+}
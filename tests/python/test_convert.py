@@ -52,6 +52,77 @@ def test_convert_to_vertices_and_faces(sample_triangles):
             assert vertex_idx < len(vertices)
 
 
+def test_convert_to_vertices_and_faces_outputs_are_owned(sample_triangles):
+    vertices, faces = openstl.convert.verticesandfaces(sample_triangles)
+    for array in (vertices, faces):
+        assert array.flags.c_contiguous
+        assert array.base is not None # Storage handed over by the conversion, not copied
+    del sample_triangles
+    np.testing.assert_array_equal(vertices[faces][0], [[1, 1, 1], [2, 2, 2], [3, 3, 3]])
+
+
+@pytest.mark.parametrize("num_threads", [0, 2, 5])
+def test_convert_to_vertices_and_faces_parallel(num_threads):
+    rng = np.random.default_rng(0)
+    points = rng.integers(0, 50, size=(3000, 3)).astype(np.float32)
+    triangles = np.zeros((20000, 4, 3), dtype=np.float32)
+    triangles[:, 1:, :] = points[rng.integers(0, len(points), size=(20000, 3))]
+
+    vertices, faces = openstl.convert.verticesandfaces(triangles)
+    par_vertices, par_faces = openstl.convert.verticesandfaces(triangles, num_threads=num_threads)
+    np.testing.assert_array_equal(vertices, par_vertices)
+    np.testing.assert_array_equal(faces, par_faces)
+    np.testing.assert_array_equal(par_vertices[par_faces], triangles[:, 1:, :])
+
+
+def test_convert_to_vertices_and_faces_morton_order(sample_triangles):
+    vertices, faces = openstl.convert.verticesandfaces(
+        sample_triangles, vertex_order=openstl.convert.vertex_order.morton)
+    np.testing.assert_array_equal(vertices[faces], sample_triangles[:, 1:, :])
+    first_vertices, _ = openstl.convert.verticesandfaces(sample_triangles)
+    assert sorted(map(tuple, vertices)) == sorted(map(tuple, first_vertices))
+
+
+def test_convert_to_vertices_and_faces_with_tolerance():
+    triangles = np.array([
+        [[0, 0, 1], [0, 0, 0], [1, 0, 0], [0, 1, 0]],
+        [[0, 0, 1], [0.9995, 0, 0], [1, 1, 0], [0, 1.0004, 0]],
+    ], dtype=np.float32)
+    vertices, faces = openstl.convert.verticesandfaces(triangles)
+    assert len(vertices) == 6
+
+    vertices, faces = openstl.convert.verticesandfaces(triangles, tolerance=1e-3)
+    assert len(vertices) == 4
+    np.testing.assert_array_equal(faces, [[0, 1, 2], [1, 3, 2]])
+
+    vertices, faces = openstl.convert.verticesandfaces(triangles, relative_tolerance=1e-3)
+    assert len(vertices) == 4
+
+
+@pytest.mark.parametrize("index_dtype", [np.uint32, np.int32, np.uint64, np.int64])
+def test_convert_with_compact_indices(sample_triangles, index_dtype):
+    vertices, faces = openstl.convert.verticesandfaces(sample_triangles, index_dtype=index_dtype)
+    assert faces.dtype == index_dtype
+    reference_vertices, reference_faces = openstl.convert.verticesandfaces(sample_triangles)
+    assert reference_faces.dtype == np.uint64
+    np.testing.assert_array_equal(faces, reference_faces)
+
+    # Faces of any integer type are read in place, and give the same triangles
+    np.testing.assert_array_equal(openstl.convert.triangles(vertices, faces),
+                                  openstl.convert.triangles(vertices, reference_faces))
+
+    with pytest.raises(ValueError):
+        openstl.convert.verticesandfaces(sample_triangles, index_dtype=np.float32)
+
+
+def test_convert_rejects_negative_indices(sample_vertices_and_faces):
+    vertices, faces = sample_vertices_and_faces
+    faces = faces.astype(np.int32)
+    faces[1, 2] = -1
+    with pytest.raises(IndexError):
+        openstl.convert.triangles(vertices, faces)
+
+
 def test_convertToVerticesAndFaces_integration(sample_vertices_and_faces):
     # Extract vertices and faces
     vertices, faces = sample_vertices_and_faces
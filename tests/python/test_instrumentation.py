@@ -0,0 +1,69 @@
+import json
+import numpy as np
+import openstl
+
+COUNTERS = {"bytes_read", "bytes_written", "triangles_parsed", "triangles_written", "hash_probes",
+            "allocations", "allocated_bytes"}
+
+
+def strip(count):
+    x = np.arange(count, dtype=np.float32)
+    triangles = np.zeros((count, 4, 3), dtype=np.float32)
+    triangles[:, 0, 2] = 1
+    triangles[:, 1, 0] = x
+    triangles[:, 2, 0] = x + 1
+    triangles[:, 3, 0] = x
+    triangles[:, 3, 1] = 1
+    return triangles
+
+
+def test_stats_layout():
+    stats = openstl.instrumentation.stats()
+    assert stats["enabled"] == openstl.instrumentation.enabled
+    assert set(stats["counters"]) == COUNTERS
+    assert isinstance(stats["timers"], dict)
+    assert stats["dropped_events"] >= 0
+
+
+def test_stages_are_recorded(tmp_path):
+    openstl.instrumentation.reset()
+    triangles = strip(1000)
+    filename = str(tmp_path / "strip.stl")
+    assert openstl.write(filename, triangles, openstl.format.binary)
+    openstl.convert.verticesandfaces(openstl.read(filename))
+    stats = openstl.instrumentation.stats()
+
+    if not openstl.instrumentation.enabled:
+        assert all(value == 0 for value in stats["counters"].values())
+        assert stats["timers"] == {}
+        return
+    counters = stats["counters"]
+    assert counters["bytes_written"] == counters["bytes_read"] == 84 + 50 * 1000
+    assert counters["triangles_written"] == counters["triangles_parsed"] == 1000
+    assert counters["hash_probes"] >= 3000
+    for stage in ("python.write", "writeBinaryStlFile", "python.read", "deserializeBinaryStl",
+                  "python.trianglesToArray", "python.verticesandfaces", "convertToVerticesAndFaces"):
+        assert stats["timers"][stage]["calls"] == 1
+        assert stats["timers"][stage]["total_seconds"] >= 0
+
+
+def test_chrome_trace(tmp_path):
+    openstl.instrumentation.reset()
+    openstl.compute_normals(strip(100))
+    trace = json.loads(openstl.instrumentation.chrome_trace())
+    events = trace["traceEvents"]
+    assert events[-1]["ph"] == "C" and set(events[-1]["args"]) == COUNTERS
+    names = {event["name"] for event in events if event["ph"] == "X"}
+    assert ("computeNormals" in names) == openstl.instrumentation.enabled
+
+    filename = tmp_path / "trace.json"
+    openstl.instrumentation.write_chrome_trace(str(filename))
+    assert json.loads(filename.read_text())["traceEvents"][-1]["ph"] == "C"
+
+
+def test_reset():
+    openstl.compute_normals(strip(10))
+    openstl.instrumentation.reset()
+    stats = openstl.instrumentation.stats()
+    assert all(value == 0 for value in stats["counters"].values())
+    assert stats["timers"] == {}
@@ -0,0 +1,48 @@
+import pytest
+import numpy as np
+import openstl
+
+
+@pytest.fixture
+def random_triangles():
+    triangles = np.random.default_rng(3).normal(size=(1000, 4, 3)).astype(np.float32)
+    return triangles
+
+
+def reference_normals(triangles):
+    normals = np.cross(triangles[:, 2] - triangles[:, 1], triangles[:, 3] - triangles[:, 1])
+    return normals / np.linalg.norm(normals, axis=1, keepdims=True)
+
+
+def test_compute_normals_in_place(random_triangles):
+    vertices = random_triangles[:, 1:].copy()
+    openstl.compute_normals(random_triangles)
+    np.testing.assert_allclose(random_triangles[:, 0], reference_normals(random_triangles), atol=1e-5)
+    np.testing.assert_array_equal(random_triangles[:, 1:], vertices)
+
+
+def test_compute_normals_on_degenerate_and_strided(random_triangles):
+    random_triangles[0, 3] = random_triangles[0, 2]
+    view = random_triangles[::2]
+    openstl.compute_normals(view)
+    np.testing.assert_array_equal(random_triangles[0, 0], [0, 0, 0])
+    np.testing.assert_allclose(random_triangles[2::2, 0], reference_normals(random_triangles[2::2]), atol=1e-5)
+    assert not np.allclose(random_triangles[1::2, 0], reference_normals(random_triangles[1::2]), atol=1e-5)
+
+
+def test_compute_normals_rejects_invalid_arrays(random_triangles):
+    with pytest.raises(ValueError):
+        openstl.compute_normals(random_triangles.astype(np.float64))
+    random_triangles.flags.writeable = False
+    with pytest.raises(ValueError):
+        openstl.compute_normals(random_triangles)
+
+
+def test_find_inconsistent_normals(random_triangles):
+    openstl.compute_normals(random_triangles)
+    assert len(openstl.find_inconsistent_normals(random_triangles)) == 0
+
+    random_triangles[5, 0] *= -1
+    random_triangles[7, 0] = 0
+    np.testing.assert_array_equal(openstl.find_inconsistent_normals(random_triangles), [5, 7])
+    np.testing.assert_array_equal(openstl.find_inconsistent_normals(random_triangles, angle_tolerance=3.2), [7])
@@ -30,10 +30,163 @@ def test_write_and_read(sample_triangles):
     # Clean up
     os.remove(filename)
 
-def test_fail_on_read():
-    filename = "donoexist.stl"
+def test_write_ascii_precision():
+    filename = "test_precision.stl"
+    triangles = np.full((2, 4, 3), 1.0 / 3.0, dtype=np.float32)
+    assert openstl.write(filename, triangles, openstl.format.ascii)
+    np.testing.assert_array_equal(openstl.read(filename), triangles) # Shortest round-trip output is exact
+    assert openstl.write(filename, triangles, openstl.format.ascii, precision=3)
+    with open(filename) as file:
+        assert "vertex 0.333 0.333 0.333\n" in file.read()
+    os.remove(filename)
+
+def test_write_ascii_parallel_is_identical():
+    triangles = np.random.default_rng(1).normal(size=(20000, 4, 3)).astype(np.float32)
+    contents = []
+    for num_threads in (1, 4):
+        filename = f"test_parallel_{num_threads}.stl"
+        assert openstl.write(filename, triangles, openstl.format.ascii, num_threads=num_threads)
+        with open(filename, "rb") as file:
+            contents.append(file.read())
+        os.remove(filename)
+    assert contents[0] == contents[1]
+
+def test_read_returns_owned_contiguous_array(sample_triangles):
+    filename = "test_owned.stl"
+    assert openstl.write(filename, sample_triangles, openstl.format.binary)
+
     triangles_read = openstl.read(filename)
-    assert len(triangles_read) == 0
+    os.remove(filename)
+    assert triangles_read.dtype == np.float32
+    assert triangles_read.flags.c_contiguous
+    assert triangles_read.base is not None # Storage handed over by the reader, not copied
+    gc.collect()
+    np.testing.assert_array_equal(triangles_read, sample_triangles)
+
+def test_write_and_read_mmap(sample_triangles):
+    filename = "test_mmap.stl"
+    assert openstl.write(filename, sample_triangles, openstl.format.binary)
+
+    triangles_read = openstl.read(filename, mmap=True)
+    assert triangles_read.shape == sample_triangles.shape
+    assert not triangles_read.flags.writeable
+    assert np.allclose(triangles_read, sample_triangles)
+
+    # The mapping must be released before the file can be removed on every platform
+    del triangles_read
+    gc.collect()
+    os.remove(filename)
+
+@pytest.mark.parametrize("structured", [False, True])
+def test_mmap_arrays_stay_read_only(sample_triangles, structured):
+    filename = "test_mmap_read_only.stl"
+    assert openstl.write(filename, sample_triangles, openstl.format.binary)
+    read = openstl.read_structured if structured else openstl.read
+    triangles_read = read(filename, mmap=True)
+    assert not triangles_read.flags.writeable
+    assert triangles_read.base is not None # Aliases the mapping
+    with pytest.raises(ValueError):
+        triangles_read[0] = triangles_read[1]
+    with pytest.raises(ValueError): # The mapping does not expose a writable buffer
+        triangles_read.setflags(write=True)
+
+    # Owned results, on the other hand, are writable
+    owned = read(filename)
+    assert owned.flags.writeable
+    owned[0] = owned[1]
+    del triangles_read
+    gc.collect()
+    os.remove(filename)
+
+def test_read_mmap_falls_back_on_ascii(sample_triangles):
+    filename = "test_mmap_ascii.stl"
+    assert openstl.write(filename, sample_triangles, openstl.format.ascii)
+    triangles_read = openstl.read(filename, mmap=True)
+    assert np.allclose(triangles_read, sample_triangles)
+    os.remove(filename)
+
+@pytest.mark.parametrize("fmt", [openstl.format.binary, openstl.format.ascii])
+@pytest.mark.parametrize("mmap", [False, True])
+def test_read_limits(sample_triangles, fmt, mmap):
+    filename = "test_read_limits.stl"
+    assert openstl.write(filename, sample_triangles, fmt)
+    count, size = len(sample_triangles), 50 * len(sample_triangles)
+
+    for read in (openstl.read, openstl.read_structured):
+        assert len(read(filename, mmap=mmap, max_triangles=count, memory_budget=size)) == count
+        with pytest.raises(RuntimeError, match="maximum"):
+            read(filename, mmap=mmap, max_triangles=count - 1)
+        with pytest.raises(RuntimeError, match="budget" if fmt == openstl.format.binary else "maximum"):
+            read(filename, mmap=mmap, memory_budget=size - 1)
+    gc.collect()
+    os.remove(filename)
+
+@pytest.mark.parametrize("mmap", [False, True])
+def test_read_rejects_hostile_header(mmap):
+    filename = "test_hostile_header.stl"
+    # The header announces 2^32 - 1 triangles, the file holds a single one
+    with open(filename, "wb") as file:
+        file.write(b"\0" * 80 + (2**32 - 1).to_bytes(4, "little") + b"\0" * 50)
+    with pytest.raises(RuntimeError):
+        openstl.read(filename, mmap=mmap)
+    os.remove(filename)
+
+def test_overflow_safety_is_deprecated():
+    with pytest.deprecated_call():
+        openstl.set_activate_overflow_safety(False)
+    with pytest.deprecated_call():
+        assert openstl.get_activate_overflow_safety()
+
+@pytest.mark.parametrize("fmt", [openstl.format.binary, openstl.format.ascii])
+def test_read_batches(sample_triangles, fmt):
+    filename = "test_batches.stl"
+    assert openstl.write(filename, sample_triangles, fmt)
+
+    batches = list(openstl.read_batches(filename, batch_size=300))
+    assert [len(batch) for batch in batches] == [300, 300, 300, 100]
+    assert np.allclose(np.concatenate(batches), openstl.read(filename))
+    os.remove(filename)
+
+def test_write_zeroes_attribute_byte_count(sample_triangles):
+    filename = "test_attribute_byte_count.stl"
+    # The (N,4,3) rows are 48 bytes wide, the records 50: nothing may be read past a row
+    assert openstl.write(filename, sample_triangles, openstl.format.binary)
+    records = openstl.read_structured(filename)
+    assert len(records) == len(sample_triangles)
+    assert np.all(records["attribute_byte_count"] == 0)
+    np.testing.assert_array_equal(records["v2"], sample_triangles[:, 3])
+    os.remove(filename)
+
+@pytest.mark.parametrize("mmap", [False, True])
+def test_write_and_read_structured(sample_triangles, mmap):
+    filename = "test_structured.stl"
+    triangles = np.zeros(len(sample_triangles), dtype=openstl.triangle_dtype)
+    assert triangles.dtype.itemsize == 50
+    triangles["normal"] = sample_triangles[:, 0]
+    triangles["v0"] = sample_triangles[:, 1]
+    triangles["v1"] = sample_triangles[:, 2]
+    triangles["v2"] = sample_triangles[:, 3]
+    triangles["attribute_byte_count"] = np.arange(len(triangles)) % 65536
+    assert openstl.write_structured(filename, triangles)
+
+    triangles_read = openstl.read_structured(filename, mmap=mmap)
+    assert triangles_read.shape == (len(sample_triangles),)
+    assert triangles_read.dtype == triangles.dtype
+    assert triangles_read.flags.writeable != mmap
+    np.testing.assert_array_equal(triangles_read, triangles)
+    np.testing.assert_array_equal(openstl.read(filename), sample_triangles)
+    del triangles_read
+    os.remove(filename)
+
+@pytest.mark.parametrize("mmap", [False, True])
+def test_fail_on_read(mmap):
+    filename = "donoexist.stl"
+    with pytest.raises(RuntimeError, match="donoexist.stl"):
+        openstl.read(filename, mmap=mmap)
+    with pytest.raises(RuntimeError, match="donoexist.stl"):
+        openstl.read_structured(filename, mmap=mmap)
+    with pytest.raises(RuntimeError, match="donoexist.stl"):
+        openstl.read_batches(filename)
 
 
 if __name__ == "__main__":
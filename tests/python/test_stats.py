@@ -0,0 +1,60 @@
+import pytest
+import numpy as np
+import openstl
+
+
+def unit_cube():
+    vertices = np.array([[0, 0, 0], [1, 0, 0], [1, 1, 0], [0, 1, 0],
+                         [0, 0, 1], [1, 0, 1], [1, 1, 1], [0, 1, 1]], dtype=np.float32)
+    faces = np.array([[0, 2, 1], [0, 3, 2], [4, 5, 6], [4, 6, 7], [0, 1, 5], [0, 5, 4],
+                      [3, 7, 6], [3, 6, 2], [0, 4, 7], [0, 7, 3], [1, 2, 6], [1, 6, 5]])
+    return vertices, faces
+
+
+def test_mesh_stats_of_a_cube():
+    vertices, faces = unit_cube()
+    triangles = openstl.convert.triangles(vertices, faces)
+    stats = openstl.mesh_stats(triangles)
+    assert stats.triangle_count == 12
+    assert stats.degenerate_count == 0
+    assert stats.area == pytest.approx(6.0)
+    assert stats.signed_volume == pytest.approx(1.0)
+    assert stats.centroid == pytest.approx((0.5, 0.5, 0.5))
+    assert stats.lower == (0.0, 0.0, 0.0)
+    assert stats.upper == (1.0, 1.0, 1.0)
+
+    indexed = openstl.mesh_stats_indexed(vertices, faces)
+    assert indexed.area == pytest.approx(6.0)
+    assert indexed.signed_volume == pytest.approx(1.0)
+    with pytest.raises(IndexError):
+        openstl.mesh_stats_indexed(vertices, faces + 1)
+
+
+def test_mesh_stats_against_numpy():
+    triangles = np.random.default_rng(5).normal(size=(50000, 4, 3)).astype(np.float32)
+    v0, v1, v2 = (triangles[:, k].astype(np.float64) for k in (1, 2, 3))
+    cross = np.cross(v1 - v0, v2 - v0)
+    area = np.linalg.norm(cross, axis=1).sum() / 2
+    volume = np.einsum("ij,ij->", v0, cross) / 6
+
+    stats = openstl.mesh_stats(triangles, num_threads=4)
+    assert stats.area == pytest.approx(area, rel=1e-6)
+    assert stats.signed_volume == pytest.approx(volume, rel=1e-3, abs=1e-2)
+    np.testing.assert_array_equal(stats.lower, triangles[:, 1:].reshape(-1, 3).min(axis=0))
+    np.testing.assert_array_equal(stats.upper, triangles[:, 1:].reshape(-1, 3).max(axis=0))
+    assert openstl.mesh_stats(triangles).area == stats.area
+
+
+def test_mesh_stats_accumulator_over_batches(tmp_path):
+    triangles = np.random.default_rng(6).normal(size=(10000, 4, 3)).astype(np.float32)
+    filename = str(tmp_path / "stats.stl")
+    openstl.write(filename, triangles, openstl.format.binary)
+
+    accumulator = openstl.MeshStatsAccumulator()
+    for batch in openstl.read_batches(filename, batch_size=999):
+        accumulator.add(batch)
+    streamed = accumulator.stats()
+    whole = openstl.mesh_stats(triangles)
+    assert streamed.triangle_count == whole.triangle_count
+    assert streamed.area == pytest.approx(whole.area, rel=1e-9)
+    assert streamed.lower == whole.lower
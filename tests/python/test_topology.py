@@ -1,6 +1,6 @@
 import numpy as np
 import pytest
-from openstl.topology import find_connected_components
+from openstl.topology import find_connected_components, label_connected_components, edge_adjacency
 
 @pytest.fixture
 def sample_vertices_and_faces():
@@ -85,3 +85,93 @@ def test_disconnected_vertices(sample_vertices_and_faces):
     # Expect one connected component (disconnected vertex ignored)
     assert len(connected_components) == 1
     assert len(connected_components[0]) == 3  # Only faces contribute
+
+
+def test_threads_and_invalid_indices(sample_vertices_and_faces):
+    vertices, faces = sample_vertices_and_faces
+    strips = np.concatenate([faces + 5 * k for k in range(30000)])
+    strip_vertices = np.zeros((5 * 30000, 3))
+    serial = find_connected_components(strip_vertices, strips)
+    threaded = find_connected_components(strip_vertices, strips, num_threads=4)
+    assert len(serial) == 30000
+    assert [np.asarray(c).tolist() for c in threaded] == [np.asarray(c).tolist() for c in serial]
+
+    with pytest.raises(IndexError):
+        find_connected_components(vertices, np.vstack([faces, [0, 1, 5]]))
+
+
+def test_label_connected_components(sample_vertices_and_faces):
+    vertices, faces = sample_vertices_and_faces
+    faces = np.vstack([faces[:1], faces[:1] + 5, faces[1:], faces[:1] + 8])
+    vertices = np.zeros((11, 3))
+
+    labels = label_connected_components(vertices, faces)
+    assert labels.tolist() == [0, 1, 0, 0, 2]
+
+    labels, offsets, face_order = label_connected_components(vertices, faces, num_threads=2, return_groups=True)
+    assert labels.tolist() == [0, 1, 0, 0, 2]
+    assert offsets.tolist() == [0, 3, 4, 5]
+    assert face_order.tolist() == [0, 2, 3, 1, 4]
+
+    components = find_connected_components(vertices, faces)
+    for k, component in enumerate(components):
+        assert np.array_equal(faces[face_order[offsets[k]:offsets[k + 1]]], component)
+
+    with pytest.raises(IndexError):
+        label_connected_components(vertices, np.vstack([faces, [0, 1, 11]]))
+
+
+@pytest.fixture
+def bowtie():
+    # Two tetrahedra sharing vertex 3
+    vertices = np.zeros((7, 3))
+    faces = np.array([
+        [0, 2, 1], [0, 1, 3], [1, 2, 3], [2, 0, 3],
+        [3, 5, 4], [3, 4, 6], [4, 5, 6], [5, 3, 6],
+    ])
+    return vertices, faces
+
+
+def test_edge_connectivity(bowtie):
+    vertices, faces = bowtie
+    assert len(find_connected_components(vertices, faces)) == 1
+    assert len(find_connected_components(vertices, faces, connectivity="edge")) == 2
+    labels = label_connected_components(vertices, faces, num_threads=2, connectivity="edge")
+    assert labels.tolist() == [0, 0, 0, 0, 1, 1, 1, 1]
+
+    with pytest.raises(ValueError):
+        label_connected_components(vertices, faces, connectivity="face")
+
+
+def test_edge_adjacency(sample_vertices_and_faces):
+    vertices, faces = sample_vertices_and_faces
+    adjacency = edge_adjacency(vertices, faces)
+    edges = adjacency["edges"]
+    assert edges.dtype == np.uint32
+    assert edges.tolist() == [[0, 1], [0, 2], [1, 2], [1, 3], [2, 3], [2, 4], [3, 4]]
+    assert adjacency["offsets"].tolist() == [0, 1, 2, 4, 5, 7, 8, 9]
+    for h, e in enumerate(adjacency["face_edges"]):
+        face, corner = divmod(h, 3)
+        assert sorted([faces[face][corner], faces[face][(corner + 1) % 3]]) == edges[e].tolist()
+        assert h in adjacency["half_edges"][adjacency["offsets"][e]:adjacency["offsets"][e + 1]]
+    assert adjacency["boundary_edges"].tolist() == [0, 1, 3, 5, 6]
+    assert adjacency["non_manifold_edges"].tolist() == []
+
+    fin = np.vstack([faces, [1, 2, 4]])
+    assert edge_adjacency(vertices, fin)["non_manifold_edges"].tolist() == [2]
+
+    with pytest.raises(IndexError):
+        edge_adjacency(vertices, np.vstack([faces, [0, 1, 5]]))
+
+
+@pytest.mark.parametrize("dtype", [np.int32, np.uint32, np.int64, np.uint64])
+def test_integer_face_types(bowtie, dtype):
+    vertices, faces = bowtie
+    faces = faces.astype(dtype)
+    labels = label_connected_components(vertices, faces, connectivity="edge")
+    assert labels.tolist() == [0, 0, 0, 0, 1, 1, 1, 1]
+    assert edge_adjacency(vertices, faces)["edges"].shape == (12, 2)
+
+    # Non-contiguous faces are copied once
+    wide = np.hstack([faces, faces])[:, ::2]
+    assert len(find_connected_components(vertices, wide)) == 1
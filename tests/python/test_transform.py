@@ -0,0 +1,72 @@
+import pytest
+import numpy as np
+import openstl
+
+
+@pytest.fixture
+def random_triangles():
+    triangles = np.random.default_rng(4).normal(size=(1001, 4, 3)).astype(np.float32)
+    openstl.compute_normals(triangles)
+    return triangles
+
+
+def affine_matrix():
+    cos, sin = np.cos(np.pi / 3), np.sin(np.pi / 3)
+    rotation = np.array([[cos, -sin, 0], [sin, cos, 0], [0, 0, 1]])
+    return np.hstack([rotation @ np.diag([2.0, 3.0, 0.5]), [[1.0], [-2.0], [3.0]]])
+
+
+def test_transform_vertices_and_normals(random_triangles):
+    matrix = affine_matrix()
+    expected = random_triangles[:, 1:] @ matrix[:, :3].T + matrix[:, 3]
+    normals = random_triangles[:, 0] @ np.linalg.inv(matrix[:, :3])
+    normals /= np.linalg.norm(normals, axis=1, keepdims=True)
+    openstl.transform(random_triangles, matrix)
+    np.testing.assert_allclose(random_triangles[:, 1:], expected, rtol=1e-5, atol=1e-4)
+    np.testing.assert_allclose(random_triangles[:, 0], normals, atol=1e-5)
+
+
+@pytest.mark.parametrize("shape", [(3, 3), (3, 4), (4, 4)])
+def test_transform_matrix_shapes(random_triangles, shape):
+    matrix = np.eye(4)[:shape[0], :shape[1]].copy()
+    matrix[0, 0] = 2.0
+    expected = random_triangles[:, 1:].copy()
+    expected[..., 0] *= 2.0
+    openstl.transform(random_triangles, matrix)
+    np.testing.assert_allclose(random_triangles[:, 1:], expected)
+
+
+def test_transform_threads_and_views(random_triangles):
+    matrix = affine_matrix()
+    original = random_triangles.copy()
+    threaded = random_triangles.copy()
+    openstl.transform(random_triangles[::2], matrix)
+    openstl.transform(threaded[::2], matrix, num_threads=4)
+    np.testing.assert_array_equal(random_triangles, threaded)
+    np.testing.assert_array_equal(random_triangles[1::2], original[1::2])
+
+
+def test_transform_vertices(random_triangles):
+    matrix = affine_matrix()
+    vertices = random_triangles[:, 1:].reshape(-1, 3).copy()
+    expected = vertices @ matrix[:, :3].T + matrix[:, 3]
+    openstl.transform_vertices(vertices, matrix, num_threads=0)
+    np.testing.assert_allclose(vertices, expected, rtol=1e-5, atol=1e-4)
+
+    padded = np.ones((len(vertices), 4), dtype=np.float32)
+    padded[:, :3] = random_triangles[:, 1:].reshape(-1, 3)
+    openstl.transform_vertices(padded[:, :3], matrix)
+    np.testing.assert_allclose(padded[:, :3], expected, rtol=1e-5, atol=1e-4)
+    np.testing.assert_array_equal(padded[:, 3], 1.0)
+
+
+def test_transform_rejects_invalid_arguments(random_triangles):
+    with pytest.raises(ValueError):
+        openstl.transform(random_triangles, np.eye(2))
+    with pytest.raises(ValueError):
+        openstl.transform(random_triangles, np.ones((4, 4)))
+    with pytest.raises(ValueError):
+        openstl.transform_vertices(random_triangles[:, 1:].reshape(-1, 3).astype(np.float64), np.eye(3))
+    random_triangles.flags.writeable = False
+    with pytest.raises(ValueError):
+        openstl.transform(random_triangles, np.eye(3))